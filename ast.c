@@ -11,6 +11,9 @@ ASTNode* create_node(NodeType type, int line) {
     node->left = NULL; node->right = NULL; 
     node->else_body = NULL; node->next = NULL; 
     node->id = NULL;
+    node->int_val = 0;
+    node->float_val = 0.0f;
+    node->memo = 0;
     return node;
 }
 
@@ -34,6 +37,22 @@ ASTNode* create_decl(char* name, DataType type, int line) {
     node->id = strdup(name); node->data_type = type; return node;
 }
 
+// Boyut NULL ise bos (0 elemanli) dinamik dizi
+ASTNode* create_array_decl(char* name, DataType elem_type, ASTNode* size, int line) {
+    ASTNode* node = create_decl(name, ARRAY_OF(elem_type), line);
+    node->left = size; return node;
+}
+
+ASTNode* create_index(char* name, ASTNode* index, int line) {
+    ASTNode* node = create_node(NODE_INDEX, line);
+    node->id = strdup(name); node->left = index; return node;
+}
+
+ASTNode* create_index_assign(char* name, ASTNode* index, ASTNode* expr, int line) {
+    ASTNode* node = create_node(NODE_INDEX_ASSIGN, line);
+    node->id = strdup(name); node->left = index; node->right = expr; return node;
+}
+
 ASTNode* create_binop(char* op, ASTNode* left, ASTNode* right, int line) {
     ASTNode* node = create_node(NODE_BINOP, line);
     node->id = strdup(op); node->left = left; node->right = right; return node;
@@ -59,6 +78,14 @@ ASTNode* create_while(ASTNode* cond, ASTNode* body, int line) {
     node->left = cond; node->right = body; return node;
 }
 
+// Sinirlar ve adim, cagri argumanlari gibi left uzerinden next ile zincirlenir
+ASTNode* create_for(char* var_name, ASTNode* from, ASTNode* to, ASTNode* step, ASTNode* body, int line) {
+    ASTNode* node = create_node(NODE_FOR, line);
+    node->id = strdup(var_name);
+    from->next = to; to->next = step;
+    node->left = from; node->right = body; return node;
+}
+
 ASTNode* create_read(char* var_name, int line) {
     ASTNode* node = create_node(NODE_READ, line);
     node->id = strdup(var_name); return node;
@@ -104,21 +131,54 @@ ASTNode* create_param(char* name, DataType type, int line) {
     return node;
 }
 
+ASTNode* create_spawn(char* var_name, ASTNode* call, int line) {
+    ASTNode* node = create_node(NODE_SPAWN, line);
+    node->id = var_name ? strdup(var_name) : NULL;
+    node->left = call;
+    return node;
+}
+
+ASTNode* create_join(int line) {
+    return create_node(NODE_JOIN, line);
+}
+
+// Alt agaci (next zinciri dahil) derin kopyalar
+ASTNode* clone_ast(ASTNode* node) {
+    if (node == NULL) return NULL;
+    ASTNode* copy = create_node(node->type, node->line);
+    copy->data_type = node->data_type;
+    copy->id = node->id ? strdup(node->id) : NULL;
+    copy->int_val = node->int_val;
+    copy->float_val = node->float_val;
+    copy->memo = node->memo;
+    copy->left = clone_ast(node->left);
+    copy->right = clone_ast(node->right);
+    copy->else_body = clone_ast(node->else_body);
+    copy->next = clone_ast(node->next);
+    return copy;
+}
+
 void print_ast_tree(ASTNode* node, int depth) {
     if (node == NULL) return;
     for (int i = 0; i < depth; i++) printf("  | ");
 
     switch (node->type) {
         case NODE_PROGRAM: printf("PROGRAM\n"); break;
-        case NODE_FUNC_DECL: printf("FUNCTION: %s (Ret: %s)\n", node->id, (node->data_type==TYPE_INT?"INT":"FLOAT")); break;
+        case NODE_FUNC_DECL: printf("FUNCTION: %s (Ret: %s)%s\n", node->id, (node->data_type==TYPE_INT?"INT":"FLOAT"), node->memo ? " [memo]" : ""); break;
         case NODE_PARAM:   printf("PARAM: %s\n", node->id); break;
         case NODE_FUNC_CALL: printf("CALL: %s\n", node->id); break;
         case NODE_RETURN:  printf("RETURN\n"); break;
         case NODE_BLOCK:   printf("BLOCK\n"); break;
-        case NODE_DECL:    printf("DECL: %s\n", node->id); break;
+        case NODE_DECL:    printf("DECL: %s%s\n", node->id, IS_ARRAY_TYPE(node->data_type) ? " []" : ""); break;
         case NODE_ASSIGN:  printf("ASSIGN: %s\n", node->id); break;
         case NODE_IF:      printf("IF\n"); break;
         case NODE_WHILE:   printf("WHILE\n"); break;
+        case NODE_FOR:     printf("FOR: %s\n", node->id); break;
+        case NODE_INDEX:   printf("INDEX: %s\n", node->id); break;
+        case NODE_INDEX_ASSIGN: printf("INDEX_ASSIGN: %s\n", node->id); break;
+        case NODE_BUILTIN: printf("BUILTIN: %s\n", node->id); break;
+        case NODE_SPAWN:   printf("SPAWN: %s\n", node->id ? node->id : "-"); break;
+        case NODE_JOIN:    printf("JOIN\n"); break;
         case NODE_READ:    printf("READ: %s\n", node->id); break;
         case NODE_PRINT:   printf("PRINT\n"); break;
         case NODE_BINOP:   printf("OP: %s\n", node->id); break;
@@ -10,15 +10,27 @@ typedef enum {
     NODE_FUNC_DECL, // Fonksiyon Tanimlama
     NODE_FUNC_CALL, // Fonksiyon Cagirma
     NODE_RETURN,    // Return ifadesi
-    NODE_PARAM      // Parametre
+    NODE_PARAM,     // Parametre
+    NODE_FOR,       // Sayacli dongu: left = baslangic -> bitis -> adim, right = govde
+    NODE_INDEX,     // Dizi elemani okuma: id[left]
+    NODE_INDEX_ASSIGN, // Dizi elemanina atama: id[left] := right
+    NODE_BUILTIN,   // Yerlesik dizi fonksiyonu (sum, min, max, dot, len, fill); argumanlar left
+    NODE_SPAWN,     // Gorev baslatma: left = cagri, id = sonucun yazilacagi degisken (yoksa NULL)
+    NODE_JOIN       // Cercevenin baslattigi gorevleri bekle
 } NodeType;
 
 typedef enum {
     TYPE_VOID,
     TYPE_INT,
-    TYPE_FLOAT
+    TYPE_FLOAT,
+    TYPE_INT_ARRAY,
+    TYPE_FLOAT_ARRAY
 } DataType;
 
+#define IS_ARRAY_TYPE(t) ((t) == TYPE_INT_ARRAY || (t) == TYPE_FLOAT_ARRAY)
+#define ELEMENT_TYPE(t) ((t) == TYPE_INT_ARRAY ? TYPE_INT : ((t) == TYPE_FLOAT_ARRAY ? TYPE_FLOAT : (t)))
+#define ARRAY_OF(t) ((t) == TYPE_INT ? TYPE_INT_ARRAY : TYPE_FLOAT_ARRAY)
+
 typedef struct ASTNode {
     NodeType type;
     DataType data_type; 
@@ -26,6 +38,7 @@ typedef struct ASTNode {
     int int_val;
     float float_val;
     int line;
+    int memo;                  // Fonksiyon icin: 'memo' ile isaretlendi mi
     struct ASTNode *left;      // Sol cocuk (Genelde ifade veya parametre listesi)
     struct ASTNode *right;     // Sag cocuk (Genelde Govde / Body)
     struct ASTNode *else_body; // If-Else icin
@@ -38,11 +51,15 @@ ASTNode* create_int(int val, int line);
 ASTNode* create_float(float val, int line);
 ASTNode* create_var(char* name, int line);
 ASTNode* create_decl(char* name, DataType type, int line);
+ASTNode* create_array_decl(char* name, DataType elem_type, ASTNode* size, int line);
+ASTNode* create_index(char* name, ASTNode* index, int line);
+ASTNode* create_index_assign(char* name, ASTNode* index, ASTNode* expr, int line);
 ASTNode* create_binop(char* op, ASTNode* left, ASTNode* right, int line);
 ASTNode* create_assign(char* var_name, ASTNode* expr, int line);
 ASTNode* create_if(ASTNode* cond, ASTNode* body, ASTNode* else_body, int line);
 ASTNode* create_unless(ASTNode* cond, ASTNode* body, int line);
 ASTNode* create_while(ASTNode* cond, ASTNode* body, int line);
+ASTNode* create_for(char* var_name, ASTNode* from, ASTNode* to, ASTNode* step, ASTNode* body, int line);
 ASTNode* create_read(char* var_name, int line);
 ASTNode* create_print(ASTNode* expr, int line);
 ASTNode* create_block(ASTNode* statements, int line);
@@ -52,7 +69,10 @@ ASTNode* create_func_decl(char* name, DataType ret_type, ASTNode* params, ASTNod
 ASTNode* create_func_call(char* name, ASTNode* args, int line);
 ASTNode* create_return(ASTNode* expr, int line);
 ASTNode* create_param(char* name, DataType type, int line);
+ASTNode* create_spawn(char* var_name, ASTNode* call, int line);
+ASTNode* create_join(int line);
 
+ASTNode* clone_ast(ASTNode* node);
 void print_ast_tree(ASTNode* node, int depth);
 void free_ast(ASTNode* node);
 
@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "compiler.h"
+#include "cache.h"
+
+// Bytecode bicimi ya da kod uretimi degistiginde artirilir; eski kayitlar
+// boylece kendiliginden gecersiz kalir
+#define CACHE_VERSION 2
+
+static char cache_dir[256];
+
+void cache_open(const char* dir) {
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Uyari: Onbellek dizini '%s' olusturulamadi, onbellek kapali.\n", dir);
+        return;
+    }
+    snprintf(cache_dir, sizeof(cache_dir), "%s", dir);
+}
+
+int cache_enabled() {
+    return cache_dir[0] != '\0';
+}
+
+// --- OZET (FNV-1a, 64 bit) ---
+
+static unsigned long long mix(unsigned long long h, const void* data, size_t len) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < len; i++) h = (h ^ p[i]) * 1099511628211ULL;
+    return h;
+}
+
+static unsigned long long mix_int(unsigned long long h, int v) {
+    return mix(h, &v, sizeof(v));
+}
+
+static unsigned long long mix_str(unsigned long long h, const char* s) {
+    if (s == NULL) return mix_int(h, -1);
+    return mix(h, s, strlen(s) + 1);
+}
+
+static unsigned long long hash_node(unsigned long long h, ASTNode* node) {
+    for (; node != NULL; node = node->next) {
+        h = mix_int(h, node->type);
+        h = mix_int(h, node->data_type);
+        h = mix_str(h, node->id);
+        h = mix_int(h, node->int_val);
+        h = mix(h, &node->float_val, sizeof(node->float_val));
+        h = mix_int(h, node->memo);
+        h = hash_node(h, node->left);
+        h = mix_int(h, 0x7f); // Cocuk sinirlari: left / right / else ayrisin
+        h = hash_node(h, node->right);
+        h = mix_int(h, 0x7e);
+        h = hash_node(h, node->else_body);
+        h = mix_int(h, 0x7d);
+    }
+    return h;
+}
+
+static unsigned long long hash_signature(unsigned long long h, const char* name) {
+    int f_idx = lookup_function((char*)name);
+    h = mix_str(h, name);
+    if (f_idx == -1) return mix_int(h, -1);
+    FunctionSymbol* fs = &func_table[f_idx];
+    h = mix_int(h, fs->return_type);
+    h = mix_int(h, fs->param_count);
+    h = mix(h, fs->param_types, sizeof(DataType) * fs->param_count);
+    h = mix_int(h, fs->is_pure);
+    return mix_int(h, fs->memoize);
+}
+
+static unsigned long long hash_callees(unsigned long long h, ASTNode* node) {
+    for (; node != NULL; node = node->next) {
+        if (node->type == NODE_FUNC_CALL) h = hash_signature(h, node->id);
+        h = hash_callees(h, node->left);
+        h = hash_callees(h, node->right);
+        h = hash_callees(h, node->else_body);
+    }
+    return h;
+}
+
+unsigned long long function_hash(ASTNode* func) {
+    unsigned long long h = 14695981039346656037ULL;
+    h = mix_int(h, CACHE_VERSION);
+    h = mix_int(h, optimize_enabled);
+    h = hash_signature(h, func->id);
+    ASTNode* rest = func->next; // Sonraki fonksiyonlar ozete girmez
+    func->next = NULL;
+    h = hash_node(h, func);
+    func->next = rest;
+    return hash_callees(h, func->right);
+}
+
+// --- ONBELLEK DOSYALARI ---
+
+static void entry_path(char* out, size_t size, unsigned long long hash) {
+    snprintf(out, size, "%s/%016llx.fn", cache_dir, hash);
+}
+
+char* cache_load(unsigned long long hash) {
+    char path[320];
+    entry_path(path, sizeof(path), hash);
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* code = (char*)malloc(len + 1);
+    if (code == NULL || fread(code, 1, len, f) != (size_t)len) {
+        free(code);
+        fclose(f);
+        return NULL;
+    }
+    code[len] = '\0';
+    fclose(f);
+    return code;
+}
+
+// Gecici dosyaya yazilip yeniden adlandirilir: yarim kalan kayit okunmaz
+void cache_store(unsigned long long hash, const char* code, size_t len) {
+    char path[320], tmp[340];
+    entry_path(path, sizeof(path), hash);
+    snprintf(tmp, sizeof(tmp), "%s.%d.tmp", path, (int)getpid());
+    FILE* f = fopen(tmp, "wb");
+    if (!f) return;
+    int ok = fwrite(code, 1, len, f) == len;
+    if (fclose(f) != 0) ok = 0;
+    if (!ok || rename(tmp, path) != 0) remove(tmp);
+}
+
+// --- BAGLAYICI ---
+// Etiketler LABEL_<TUR>_<n> bicimindedir (tanimda sonda ':' olur)
+
+int link_function(FILE* out, const char* code, int base) {
+    int count = 0;
+    const char* p = code;
+    while (*p) {
+        int token_start = (p == code || p[-1] == ' ' || p[-1] == '\n');
+        if (token_start && strncmp(p, "LABEL_", 6) == 0) {
+            const char* q = p + 6;
+            while (*q >= 'A' && *q <= 'Z') q++;
+            if (*q == '_' && q[1] >= '0' && q[1] <= '9') {
+                char* end;
+                long n = strtol(q + 1, &end, 10);
+                fprintf(out, "%.*s%ld", (int)(q + 1 - p), p, n + base);
+                if (n + 1 > count) count = (int)n + 1;
+                p = end;
+                continue;
+            }
+        }
+        fputc(*p++, out);
+    }
+    return count;
+}
@@ -0,0 +1,25 @@
+#ifndef CACHE_H
+#define CACHE_H
+#include <stdio.h>
+#include "ast.h"
+
+// --- ARTIMLI DERLEME ---
+// Her fonksiyonun bytecode'u, optimize edilmis AST'inden ve bagli oldugu
+// imzalardan (kendisi ve cagirdiklari, func_table'dan) hesaplanan bir
+// ozetle (hash) onbellek dizininde saklanir. Ozeti degismeyen fonksiyonlar
+// IR'a indirilmeden dosyadan alinir.
+//
+// Fonksiyon kodundaki etiket numaralari fonksiyona yereldir; link_function
+// fonksiyonlari birlestirirken onlari program capinda yeniden numaralar.
+
+void cache_open(const char* dir);
+int cache_enabled();
+unsigned long long function_hash(ASTNode* func);
+char* cache_load(unsigned long long hash);   // Yoksa NULL; malloc'lu metin
+void cache_store(unsigned long long hash, const char* code, size_t len);
+
+// Kodu yerel etiketleri 'base' kadar kaydirarak yazar; kullanilan etiket
+// sayisini doner
+int link_function(FILE* out, const char* code, int base);
+
+#endif
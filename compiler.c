@@ -3,10 +3,10 @@
 #include <string.h>
 #include <math.h>
 #include "compiler.h"
+#include "ir.h"
+#include "cache.h"
 
 #define MAX_VARS 100
-#define MAX_FUNCS 50
-#define MAX_PARAMS 10
 
 // --- SEMBOL TABLOSU (DEGISKENLER ICIN) ---
 typedef struct {
@@ -21,17 +21,16 @@ int symbol_count = 0;
 int current_scope = 0;
 
 // --- FONKSIYON TABLOSU ---
-typedef struct {
-    char name[32];
-    DataType return_type;
-    int param_count;
-    DataType param_types[MAX_PARAMS];
-} FunctionSymbol;
-
 FunctionSymbol func_table[MAX_FUNCS];
 int func_count = 0;
+int optimize_enabled = 1;
 DataType current_func_return_type; // Track current function's return type
 
+// Icinde bulunulan for donglerinin sayaclari (govdede degistirilemezler)
+#define MAX_LOOP_DEPTH 32
+char* loop_vars[MAX_LOOP_DEPTH];
+int loop_depth = 0;
+
 // --- YARDIMCI FONKSIYONLAR ---
 
 int lookup_symbol(char* name) {
@@ -85,6 +84,9 @@ void add_function(char* name, DataType ret_type, int line) {
     strcpy(func_table[func_count].name, name);
     func_table[func_count].return_type = ret_type;
     func_table[func_count].param_count = 0;
+    func_table[func_count].is_pure = 0;
+    func_table[func_count].memoize = 0;
+    func_table[func_count].memo_annotated = 0;
     func_count++;
 }
 
@@ -97,12 +99,28 @@ int lookup_function(char* name) {
 
 // --- SEMANTIK ANALIZ ---
 
+int is_loop_var(char* name) {
+    for (int i = 0; i < loop_depth; i++) {
+        if (strcmp(loop_vars[i], name) == 0) return 1;
+    }
+    return 0;
+}
+
+int check_loop_write(ASTNode* node) {
+    if (is_loop_var(node->id)) {
+        fprintf(stderr, "Hata (Satir %d): Dongu sayaci '%s' dongu icinde degistirilemez!\n", node->line, node->id);
+        return 1;
+    }
+    return 0;
+}
+
 void register_functions(ASTNode* node) {
     while(node != NULL) {
         if (node->type == NODE_FUNC_DECL) {
             add_function(node->id, node->data_type, node->line);
             ASTNode* param = node->left;
             int f_idx = func_count - 1;
+            func_table[f_idx].memo_annotated = node->memo;
             while(param != NULL) {
                 if(func_table[f_idx].param_count < MAX_PARAMS) {
                     func_table[f_idx].param_types[func_table[f_idx].param_count++] = param->data_type;
@@ -114,6 +132,66 @@ void register_functions(ASTNode* node) {
     }
 }
 
+int analyze_node(ASTNode* node);
+
+// Tek bir ifadeyi (next zincirine dokunmadan) analiz et
+int analyze_expr(ASTNode* node) {
+    ASTNode* rest = node->next;
+    node->next = NULL;
+    int err = analyze_node(node);
+    node->next = rest;
+    return err;
+}
+
+// --- YERLESIK DIZI FONKSIYONLARI ---
+// Ayni isimde kullanici fonksiyonu varsa o onceliklidir.
+
+int is_builtin(char* name) {
+    static const char* names[] = {"sum", "min", "max", "dot", "len", "fill"};
+    for (int i = 0; i < 6; i++) {
+        if (strcmp(names[i], name) == 0) return 1;
+    }
+    return 0;
+}
+
+int analyze_builtin(ASTNode* node) {
+    ASTNode* args[2] = {NULL, NULL};
+    int argc = 0;
+    for (ASTNode* a = node->left; a != NULL; a = a->next) {
+        if (analyze_expr(a) != 0) return 1;
+        if (argc < 2) args[argc] = a;
+        argc++;
+    }
+    int two = strcmp(node->id, "dot") == 0 || strcmp(node->id, "fill") == 0;
+    if (argc != (two ? 2 : 1)) {
+        fprintf(stderr, "Hata (Satir %d): '%s' %d arguman bekliyor, %d verildi.\n", node->line, node->id, two ? 2 : 1, argc);
+        return 1;
+    }
+    if (!IS_ARRAY_TYPE(args[0]->data_type)) {
+        fprintf(stderr, "Hata (Satir %d): '%s' icin 1. arguman dizi olmali!\n", node->line, node->id);
+        return 1;
+    }
+    DataType elem = ELEMENT_TYPE(args[0]->data_type);
+    if (strcmp(node->id, "dot") == 0 && args[1]->data_type != args[0]->data_type) {
+        fprintf(stderr, "Hata (Satir %d): 'dot' icin 2. arguman ayni tipte dizi olmali!\n", node->line);
+        return 1;
+    }
+    if (strcmp(node->id, "fill") == 0) {
+        if (args[0]->type != NODE_VAR) {
+            fprintf(stderr, "Hata (Satir %d): 'fill' sadece dizi degiskenine uygulanabilir!\n", node->line);
+            return 1;
+        }
+        if (args[1]->data_type != elem) {
+            fprintf(stderr, "Hata (Satir %d): 'fill' icin 2. arguman tipi hatali!\n", node->line);
+            return 1;
+        }
+    }
+    if (strcmp(node->id, "len") == 0) node->data_type = TYPE_INT;
+    else if (strcmp(node->id, "fill") == 0) node->data_type = TYPE_VOID;
+    else node->data_type = elem;
+    return 0;
+}
+
 int analyze_node(ASTNode* node) {
     if (node == NULL) return 0;
 
@@ -141,6 +219,13 @@ int analyze_node(ASTNode* node) {
             break;
 
         case NODE_DECL:
+            if (node->left) { // Dizi boyutu
+                if (analyze_expr(node->left) != 0) return 1;
+                if (node->left->data_type != TYPE_INT) {
+                    fprintf(stderr, "HATA (Satir %d): Dizi boyutu tamsayi (INT) olmalidir!\n", node->line);
+                    return 1;
+                }
+            }
             add_symbol(node->id, node->data_type, node->line);
             break;
 
@@ -149,12 +234,42 @@ int analyze_node(ASTNode* node) {
                 fprintf(stderr, "Hata (Satir %d): Tanimlanmamis degisken '%s'!\n", node->line, node->id);
                 return 1;
             }
+            if (check_loop_write(node) != 0) return 1;
             if (analyze_node(node->left) != 0) return 1;
             int idx = lookup_symbol(node->id);
             if (symbol_table[idx].type != node->left->data_type) {
                 fprintf(stderr, "HATA (Satir %d): Tip uyusmazligi! Degisken %s.\n", node->line, node->id);
                 return 1;
             }
+            node->data_type = symbol_table[idx].type;
+            break;
+
+        case NODE_INDEX:
+        case NODE_INDEX_ASSIGN:
+            {
+                int idx = lookup_symbol(node->id);
+                if (idx == -1) {
+                    fprintf(stderr, "Hata (Satir %d): Tanimlanmamis degisken '%s'!\n", node->line, node->id);
+                    return 1;
+                }
+                if (!IS_ARRAY_TYPE(symbol_table[idx].type)) {
+                    fprintf(stderr, "HATA (Satir %d): '%s' bir dizi degil!\n", node->line, node->id);
+                    return 1;
+                }
+                if (analyze_expr(node->left) != 0) return 1;
+                if (node->left->data_type != TYPE_INT) {
+                    fprintf(stderr, "HATA (Satir %d): Dizi indeksi tamsayi (INT) olmalidir!\n", node->line);
+                    return 1;
+                }
+                node->data_type = ELEMENT_TYPE(symbol_table[idx].type);
+                if (node->type == NODE_INDEX_ASSIGN) {
+                    if (analyze_expr(node->right) != 0) return 1;
+                    if (node->right->data_type != node->data_type) {
+                        fprintf(stderr, "HATA (Satir %d): Tip uyusmazligi! Degisken %s.\n", node->line, node->id);
+                        return 1;
+                    }
+                }
+            }
             break;
 
         case NODE_VAR:
@@ -164,11 +279,21 @@ int analyze_node(ASTNode* node) {
                 return 1;
             }
             node->data_type = symbol_table[lookup_symbol(node->id)].type;
+            if (node->type == NODE_READ && check_loop_write(node) != 0) return 1;
+            if (node->type == NODE_READ && IS_ARRAY_TYPE(node->data_type)) {
+                fprintf(stderr, "HATA (Satir %d): Diziye dogrudan okuma yapilamaz!\n", node->line);
+                return 1;
+            }
             break;
 
         case NODE_FUNC_CALL:
             {
                 int f_idx = lookup_function(node->id);
+                if (f_idx == -1 && is_builtin(node->id)) {
+                    node->type = NODE_BUILTIN;
+                    if (analyze_builtin(node) != 0) return 1;
+                    break;
+                }
                 if (f_idx == -1) {
                     fprintf(stderr, "Hata (Satir %d): Tanimlanmamis fonksiyon '%s'!\n", node->line, node->id);
                     return 1;
@@ -195,6 +320,37 @@ int analyze_node(ASTNode* node) {
             }
             break;
 
+        case NODE_SPAWN:
+            // Gorev kendi yiginiyla baska bir is parcaciginda calisir. Diziler
+            // referansla gectigi icin gorevlere verilemez (veri yarisi).
+            if (analyze_expr(node->left) != 0) return 1;
+            if (node->left->type != NODE_FUNC_CALL || strcmp(node->left->id, "main") == 0) {
+                fprintf(stderr, "Hata (Satir %d): 'spawn' sadece kullanici fonksiyonlarini baslatabilir!\n", node->line);
+                return 1;
+            }
+            for (ASTNode* arg = node->left->left; arg != NULL; arg = arg->next) {
+                if (IS_ARRAY_TYPE(arg->data_type)) {
+                    fprintf(stderr, "HATA (Satir %d): Gorevlere dizi gecirilemez!\n", node->line);
+                    return 1;
+                }
+            }
+            if (node->id) {
+                int v_idx = lookup_symbol(node->id);
+                if (v_idx == -1) {
+                    fprintf(stderr, "Hata (Satir %d): Tanimlanmamis degisken '%s'!\n", node->line, node->id);
+                    return 1;
+                }
+                if (check_loop_write(node) != 0) return 1;
+                if (symbol_table[v_idx].type != node->left->data_type) {
+                    fprintf(stderr, "HATA (Satir %d): Tip uyusmazligi! Degisken %s.\n", node->line, node->id);
+                    return 1;
+                }
+            }
+            break;
+
+        case NODE_JOIN:
+            break;
+
         case NODE_RETURN:
             if (node->left) {
                 if (analyze_node(node->left) != 0) return 1;
@@ -220,9 +376,70 @@ int analyze_node(ASTNode* node) {
             }
             break;
 
+        case NODE_FOR:
+            {
+                int idx = lookup_symbol(node->id);
+                if (idx == -1) {
+                    fprintf(stderr, "Hata (Satir %d): Tanimlanmamis degisken '%s'!\n", node->line, node->id);
+                    return 1;
+                }
+                if (symbol_table[idx].type != TYPE_INT) {
+                    fprintf(stderr, "HATA (Satir %d): Dongu sayaci '%s' tamsayi (INT) olmalidir!\n", node->line, node->id);
+                    return 1;
+                }
+                if (check_loop_write(node) != 0) return 1;
+                // Baslangic, bitis ve adim: next ile zincirli, hepsi INT
+                for (ASTNode* e = node->left; e != NULL; e = e->next) {
+                    ASTNode* rest = e->next;
+                    e->next = NULL;
+                    int err = analyze_node(e);
+                    e->next = rest;
+                    if (err != 0) return 1;
+                    if (e->data_type != TYPE_INT) {
+                        fprintf(stderr, "HATA (Satir %d): Dongu sinirlari ve adimi tamsayi (INT) olmalidir!\n", node->line);
+                        return 1;
+                    }
+                }
+                ASTNode* step = node->left->next->next;
+                if (step != NULL && step->type == NODE_NUM_INT && step->int_val == 0) {
+                    fprintf(stderr, "HATA (Satir %d): Dongu adimi 0 olamaz!\n", node->line);
+                    return 1;
+                }
+                if (loop_depth >= MAX_LOOP_DEPTH) {
+                    fprintf(stderr, "Hata (Satir %d): Ic ice cok fazla for dongusu!\n", node->line);
+                    return 1;
+                }
+                loop_vars[loop_depth++] = node->id;
+                int err = analyze_node(node->right);
+                loop_depth--;
+                if (err != 0) return 1;
+            }
+            break;
+
+        case NODE_BUILTIN:
+            if (analyze_builtin(node) != 0) return 1;
+            break;
+
         case NODE_BINOP:
             if (analyze_node(node->left) != 0) return 1;
             if (analyze_node(node->right) != 0) return 1;
+            if (node->left->data_type == TYPE_VOID || node->right->data_type == TYPE_VOID) {
+                fprintf(stderr, "HATA (Satir %d): Deger dondurmeyen ifade islemde kullanilamaz!\n", node->line);
+                return 1;
+            }
+            if (IS_ARRAY_TYPE(node->left->data_type) || IS_ARRAY_TYPE(node->right->data_type)) {
+                // Eleman bazinda: dizi-dizi ya da dizi-skaler
+                if (strlen(node->id) != 1 || strchr("+-*/", node->id[0]) == NULL) {
+                    fprintf(stderr, "HATA (Satir %d): Diziler sadece + - * / ile islenebilir!\n", node->line);
+                    return 1;
+                }
+                if (ELEMENT_TYPE(node->left->data_type) != ELEMENT_TYPE(node->right->data_type)) {
+                    fprintf(stderr, "HATA (Satir %d): Farkli tiplerle islem yapilamaz!\n", node->line);
+                    return 1;
+                }
+                node->data_type = ARRAY_OF(ELEMENT_TYPE(node->left->data_type));
+                break;
+            }
             if (node->left->data_type != node->right->data_type) {
                 fprintf(stderr, "HATA (Satir %d): Farkli tiplerle islem yapilamaz!\n", node->line);
                 return 1;
@@ -232,6 +449,10 @@ int analyze_node(ASTNode* node) {
 
         case NODE_PRINT:
             if (analyze_node(node->left) != 0) return 1;
+            if (node->left->data_type == TYPE_VOID || IS_ARRAY_TYPE(node->left->data_type)) {
+                fprintf(stderr, "HATA (Satir %d): Sadece int ya da float yazdirilabilir!\n", node->line);
+                return 1;
+            }
             break;
             
         case NODE_NUM_INT: node->data_type = TYPE_INT; break;
@@ -247,16 +468,106 @@ int semantic_analysis(ASTNode* node) {
     symbol_count = 0;
     current_scope = 0;
     func_count = 0;
+    loop_depth = 0;
     return analyze_node(node);
 }
 
+// --- SAFLIK (PURITY) ANALIZI ---
+// Dilde global degisken yok; bir fonksiyonun gordugu tum degiskenler
+// parametre ya da yerel. Bu yuzden saflik = read/print yok ve sadece saf
+// fonksiyonlari cagiriyor. Cagri grafi uzerinde "hepsi saf" varsayimindan
+// baslayip saf olmayanlari eleyerek (en buyuk sabit nokta) hesaplanir;
+// boylece ozyinelemeli fonksiyonlar da saf sayilabilir.
+
+// Govdede saf olmayan bir islem var mi?
+static int has_impure_op(ASTNode* node) {
+    if (node == NULL) return 0;
+    if (node->type == NODE_READ || node->type == NODE_PRINT) return 1;
+    if (node->type == NODE_FUNC_CALL) {
+        int f_idx = lookup_function(node->id);
+        if (f_idx == -1 || !func_table[f_idx].is_pure) return 1;
+    }
+    return has_impure_op(node->left) || has_impure_op(node->right) ||
+           has_impure_op(node->else_body) || has_impure_op(node->next);
+}
+
+// Govdede 'name' fonksiyonuna kac cagri var?
+static int count_calls(ASTNode* node, const char* name) {
+    if (node == NULL) return 0;
+    // spawn edilen cagri gorevde calisir ve memo kontrolunden gecmez;
+    // yalnizca argumanlari bu cercevede hesaplanir
+    if (node->type == NODE_SPAWN) return count_calls(node->left->left, name) + count_calls(node->next, name);
+    int n = (node->type == NODE_FUNC_CALL && strcmp(node->id, name) == 0);
+    return n + count_calls(node->left, name) + count_calls(node->right, name) +
+           count_calls(node->else_body, name) + count_calls(node->next, name);
+}
+
+void analyze_purity(ASTNode* program) {
+    for (int i = 0; i < func_count; i++) func_table[i].is_pure = 1;
+
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (ASTNode* f = program->left; f != NULL; f = f->next) {
+            if (f->type != NODE_FUNC_DECL) continue;
+            int f_idx = lookup_function(f->id);
+            if (f_idx == -1 || !func_table[f_idx].is_pure) continue;
+            // Dizi parametreleri referansla gecer: icerigi cagirana aittir
+            int array_param = 0;
+            for (int k = 0; k < func_table[f_idx].param_count; k++) {
+                if (IS_ARRAY_TYPE(func_table[f_idx].param_types[k])) array_param = 1;
+            }
+            if (array_param || has_impure_op(f->right)) {
+                func_table[f_idx].is_pure = 0;
+                changed = 1;
+            }
+        }
+    }
+
+    // Onbellek: 'memo' ile isaretli saf fonksiyonlar, ya da kendini en az iki
+    // kez cagiran (fib gibi ustel dallanan) saf fonksiyonlar.
+    for (ASTNode* f = program->left; f != NULL; f = f->next) {
+        if (f->type != NODE_FUNC_DECL) continue;
+        int f_idx = lookup_function(f->id);
+        if (f_idx == -1) continue;
+        FunctionSymbol* fs = &func_table[f_idx];
+        fs->memoize = 0;
+        if (strcmp(f->id, "main") == 0 || fs->param_count == 0) continue;
+        if (fs->memo_annotated && !fs->is_pure) {
+            fprintf(stderr, "Uyari (Satir %d): '%s' saf degil, 'memo' yok sayildi.\n", f->line, f->id);
+            continue;
+        }
+        if (fs->is_pure && (fs->memo_annotated || count_calls(f->right, f->id) >= 2)) {
+            fs->memoize = 1;
+        }
+    }
+}
+
 // --- SANAL MAKINE (VM) & KOD URETIMI ---
+// Her fonksiyon IR'a indirilir, optimize edilir ve bytecode olarak yazilir.
 
 // YENI: Dosya pointer'ı
 static FILE *vm_out = NULL;
-int label_counter = 0;
 
-void generate_node_code(ASTNode* node);
+// Fonksiyonun parametre girisi ve govdesi (etiketler yerel numarali)
+static void emit_function_body(ASTNode* func, FILE* out) {
+    // Calling convention: argumanlar sirayla push edilir, CALL yapilir.
+    // Fonksiyon girisinde sondan basa pop edilip parametrelere STORE edilir.
+    char* params[MAX_PARAMS];
+    int p_count = 0;
+    for (ASTNode* p = func->left; p != NULL && p_count < MAX_PARAMS; p = p->next) {
+        params[p_count++] = p->id;
+    }
+    for(int i=p_count-1; i>=0; i--) {
+        fprintf(out, "STORE %s\n", params[i]);
+    }
+
+    // Govde: AST -> IR (CFG + SSA) -> optimizasyon -> bytecode
+    IRFunction* fn = ir_build(func);
+    if (optimize_enabled) ir_optimize(fn);
+    ir_emit(fn, out);
+    ir_free(fn);
+}
 
 void generate_code(ASTNode* node, const char* filename) {
     // Dosyayı yazma modunda aç
@@ -266,167 +577,55 @@ void generate_code(ASTNode* node, const char* filename) {
         return;
     }
 
+    analyze_purity(node);
+    int labels = 0, reused = 0, compiled = 0;
+
     // Programın başlangıcı - Main'e atla
     fprintf(vm_out, "JMP MAIN\n");
 
     ASTNode* curr = node->left; 
     while(curr != NULL) {
         if (curr->type == NODE_FUNC_DECL) {
-            if (strcmp(curr->id, "main") == 0) {
+            int in_main = (strcmp(curr->id, "main") == 0);
+            if (in_main) {
                 fprintf(vm_out, "MAIN:\n");
             } else {
                 fprintf(vm_out, "FUNC_%s:\n", curr->id);
             }
-            // Parametreleri stack'ten alıp yerel değişkenlere ata (ters sırada)
-            // VM implementasyonunda parametreler stack'te olacak.
-            // Burada basit bir implementasyon yapıyoruz, parametreleri DECLARE ve STORE ile alıyoruz.
-            // Ancak bizim dilimizde parametreler zaten scope içinde tanımlı semboller.
-            // VM tarafında CALL işlemi parametreleri stack'e atmış olmalı.
-            // Fonksiyon girişinde bu değerleri pop edip ilgili değişkenlere store etmeliyiz.
-            
-            ASTNode* param = curr->left;
-            // Parametreler stack'te: arg1, arg2, ... (en üstte son argüman var varsayalım veya tam tersi)
-            // Genelde calling convention: push arg1, push arg2 -> call. Stack top: arg2.
-            // O zaman pop -> arg2, pop -> arg1.
-            // Yani parametre listesinin tersini almalıyız ya da VM'i ona göre ayarlamalıyız.
-            // Basitlik için: VM tarafında CALL yapılırken argümanlar sırayla pushlanır.
-            // Fonksiyon içinde sondan başa doğru pop yapılır.
-            
-            // Parametre sayısını bul
-            int p_count = 0;
-            ASTNode* p = param;
-            while(p) { p_count++; p = p->next; }
-            
-            // Parametreleri bir diziye alıp ters sırada işle
-            char* params[MAX_PARAMS];
-            p = param;
-            for(int i=0; i<p_count; i++) {
-                params[i] = p->id;
-                p = p->next;
-            }
-            
-            for(int i=p_count-1; i>=0; i--) {
-                fprintf(vm_out, "STORE %s\n", params[i]);
+
+            // Saf fonksiyonlari isaretle: MEMO n -> VM ilk n argumana gore onbellekler
+            int f_idx = lookup_function(curr->id);
+            if (f_idx != -1 && func_table[f_idx].memoize) {
+                fprintf(vm_out, "MEMO %d\n", func_table[f_idx].param_count);
+            } else if (f_idx != -1 && func_table[f_idx].is_pure && !in_main) {
+                fprintf(vm_out, "PURE %d\n", func_table[f_idx].param_count);
             }
 
-            generate_node_code(curr->right); 
-            
-            // Void fonksiyonlar için otomatik return (main hariç, main exit eder)
-            if (strcmp(curr->id, "main") != 0) {
-                fprintf(vm_out, "RETURN\n");
+            // Ozeti degismemis fonksiyon onbellekten gelir
+            unsigned long long hash = 0;
+            char* code = NULL;
+            size_t len = 0;
+            if (cache_enabled()) {
+                hash = function_hash(curr);
+                code = cache_load(hash);
+            }
+            if (code != NULL) {
+                reused++;
             } else {
-                fprintf(vm_out, "HALT\n");
+                FILE* mem = open_memstream(&code, &len);
+                emit_function_body(curr, mem);
+                fclose(mem);
+                if (cache_enabled()) cache_store(hash, code, len);
+                compiled++;
             }
+            labels += link_function(vm_out, code, labels);
+            free(code);
         }
         curr = curr->next;
     }
     
     fclose(vm_out);
-}
-
-void generate_node_code(ASTNode* node) {
-    if (node == NULL) return;
-    int lbl1, lbl2;
-
-    switch (node->type) {
-        case NODE_PROGRAM: 
-            break;
-
-        case NODE_BLOCK: 
-            {
-                ASTNode* stmt = node->left;
-                while(stmt != NULL) {
-                    generate_node_code(stmt);
-                    stmt = stmt->next;
-                }
-            }
-            break;
-        case NODE_DECL: fprintf(vm_out, "DECLARE %s\n", node->id); break;
-        
-        case NODE_ASSIGN:
-            generate_node_code(node->left);
-            fprintf(vm_out, "STORE %s\n", node->id);
-            break;
-            
-        case NODE_VAR:
-            fprintf(vm_out, "LOAD %s\n", node->id);
-            break;
-            
-        case NODE_NUM_INT: fprintf(vm_out, "PUSH_INT %d\n", node->int_val); break;
-        case NODE_NUM_FLOAT: fprintf(vm_out, "PUSH_FLOAT %f\n", node->float_val); break;
-        
-        case NODE_PRINT:
-            generate_node_code(node->left);
-            fprintf(vm_out, "PRINT\n");
-            break;
-
-        case NODE_WHILE:
-            lbl1 = label_counter++; lbl2 = label_counter++;
-            fprintf(vm_out, "LABEL_START_%d:\n", lbl1);
-            generate_node_code(node->left); 
-            fprintf(vm_out, "JZ LABEL_END_%d\n", lbl2);
-            generate_node_code(node->right); 
-            fprintf(vm_out, "JMP LABEL_START_%d\n", lbl1);
-            fprintf(vm_out, "LABEL_END_%d:\n", lbl2);
-            break;
-
-        case NODE_IF:
-            lbl1 = label_counter++; lbl2 = label_counter++;
-            generate_node_code(node->left);
-            fprintf(vm_out, "JZ LABEL_ELSE_%d\n", lbl1);
-            generate_node_code(node->right);
-            fprintf(vm_out, "JMP LABEL_EXIT_%d\n", lbl2);
-            fprintf(vm_out, "LABEL_ELSE_%d:\n", lbl1);
-            if (node->else_body) generate_node_code(node->else_body);
-            fprintf(vm_out, "LABEL_EXIT_%d:\n", lbl2);
-            break;
-
-        case NODE_UNLESS:
-            lbl1 = label_counter++;
-            generate_node_code(node->left);
-            fprintf(vm_out, "JNZ LABEL_SKIP_%d\n", lbl1); 
-            generate_node_code(node->right);
-            fprintf(vm_out, "LABEL_SKIP_%d:\n", lbl1);
-            break;
-
-        case NODE_BINOP:
-            generate_node_code(node->left);
-            generate_node_code(node->right);
-            if (strcmp(node->id, "+") == 0) fprintf(vm_out, "ADD\n");
-            else if (strcmp(node->id, "-") == 0) fprintf(vm_out, "SUB\n");
-            else if (strcmp(node->id, "*") == 0) fprintf(vm_out, "MUL\n");
-            else if (strcmp(node->id, "/") == 0) fprintf(vm_out, "DIV\n");
-            else if (strcmp(node->id, "%") == 0) fprintf(vm_out, "MOD\n");
-            else if (strcmp(node->id, "^") == 0) fprintf(vm_out, "POW\n");
-            else if (strcmp(node->id, ">") == 0) fprintf(vm_out, "GT\n");
-            else if (strcmp(node->id, "<") == 0) fprintf(vm_out, "LT\n");
-            else if (strcmp(node->id, "==") == 0) fprintf(vm_out, "EQ\n");
-            else if (strcmp(node->id, "!=") == 0) fprintf(vm_out, "NEQ\n");
-            break;
-
-        case NODE_RETURN:
-            if (node->left) generate_node_code(node->left);
-            fprintf(vm_out, "RETURN\n");
-            break;
-
-        case NODE_FUNC_CALL:
-            // Argümanları hesapla ve stack'e at
-            {
-                ASTNode* arg = node->left;
-                while(arg != NULL) {
-                    generate_node_code(arg);
-                    arg = arg->next;
-                }
-                fprintf(vm_out, "CALL FUNC_%s\n", node->id);
-            }
-            break;
-            
-        case NODE_READ:
-            fprintf(vm_out, "READ %s\n", node->id);
-            break;
-
-        default:
-            break;
+    if (cache_enabled()) {
+        printf("Onbellek: %d fonksiyon yeniden kullanildi, %d fonksiyon derlendi.\n", reused, compiled);
     }
-    // generate_node_code(node->next); // REMOVED TAIL RECURSION
-}
\ No newline at end of file
+}
@@ -2,7 +2,31 @@
 #define COMPILER_H
 #include "ast.h"
 
+#define MAX_FUNCS 50
+#define MAX_PARAMS 10
+
+// --- FONKSIYON TABLOSU ---
+typedef struct {
+    char name[32];
+    DataType return_type;
+    int param_count;
+    DataType param_types[MAX_PARAMS];
+    int is_pure;   // Yan etkisiz mi (read/print yok, sadece saf fonksiyon cagriyor)
+    int memoize;   // VM tarafinda sonuc onbellegi kullanilacak mi
+    int memo_annotated; // Kaynakta 'memo' ile isaretlenmis
+} FunctionSymbol;
+
+extern FunctionSymbol func_table[MAX_FUNCS];
+extern int func_count;
+
+// --no-opt ile 0: AST optimizasyonu ve IR gecisleri atlanir
+extern int optimize_enabled;
+
+void add_function(char* name, DataType ret_type, int line);
+int lookup_function(char* name);
+
 int semantic_analysis(ASTNode* node);
+void analyze_purity(ASTNode* program);
 void generate_code(ASTNode* node, const char* filename);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,1454 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "ir.h"
+
+#define GROW(arr, count, cap) do { \
+    if ((count) >= (cap)) { \
+        (cap) = (cap) ? (cap) * 2 : 8; \
+        (arr) = realloc((arr), sizeof(*(arr)) * (cap)); \
+        if (!(arr)) { fprintf(stderr, "Bellek yetersiz!\n"); exit(1); } \
+    } \
+} while (0)
+
+static IRFunction* fn;  // Uzerinde calisilan fonksiyon
+static IRBlock* cur;    // Indirme sirasinda aktif blok
+
+// --- TEMEL YAPILAR ---
+
+static IROperand opd_value(int v) {
+    IROperand o = {OPD_VALUE, v, TYPE_INT, 0, 0.0f};
+    return o;
+}
+
+static IROperand opd_int(int val) {
+    IROperand o = {OPD_CONST, -1, TYPE_INT, val, 0.0f};
+    return o;
+}
+
+static IROperand opd_float(float val) {
+    IROperand o = {OPD_CONST, -1, TYPE_FLOAT, 0, val};
+    return o;
+}
+
+static IROperand opd_none() {
+    IROperand o = {OPD_NONE, -1, TYPE_INT, 0, 0.0f};
+    return o;
+}
+
+static int same_operand(IROperand a, IROperand b) {
+    if (a.kind != b.kind) return 0;
+    if (a.kind == OPD_VALUE) return a.value == b.value;
+    if (a.kind == OPD_CONST) {
+        if (a.type != b.type) return 0;
+        if (a.type == TYPE_INT) return a.int_val == b.int_val;
+        return memcmp(&a.float_val, &b.float_val, sizeof(float)) == 0;
+    }
+    return 1;
+}
+
+static IRBlock* new_block(const char* kind) {
+    IRBlock* b = (IRBlock*)calloc(1, sizeof(IRBlock));
+    b->id = fn->block_count;
+    b->kind = kind;
+    b->label = -1;
+    GROW(fn->blocks, fn->block_count, fn->block_cap);
+    fn->blocks[fn->block_count++] = b;
+    return b;
+}
+
+static int new_value(int var) {
+    GROW(fn->values, fn->value_count, fn->value_cap);
+    IRValue* v = &fn->values[fn->value_count];
+    v->var = var;
+    v->num = var < 0 ? fn->temp_count++ : 0;
+    v->def = NULL;
+    v->uses = 0;
+    return fn->value_count++;
+}
+
+// Kaynak degiskenin SSA oncesi degeri (yoksa olusturulur)
+static int var_value(const char* name) {
+    for (int i = 0; i < fn->var_count; i++) {
+        if (strcmp(fn->vars[i], name) == 0) return fn->var_base[i];
+    }
+    int cap = fn->var_cap;
+    GROW(fn->vars, fn->var_count, fn->var_cap);
+    if (cap != fn->var_cap) fn->var_base = realloc(fn->var_base, sizeof(int) * fn->var_cap);
+    fn->vars[fn->var_count] = strdup(name);
+    fn->var_base[fn->var_count] = new_value(fn->var_count);
+    return fn->var_base[fn->var_count++];
+}
+
+static int is_var_base(int v) {
+    int var = fn->values[v].var;
+    return var >= 0 && fn->var_base[var] == v;
+}
+
+static IRInstr* make_instr(IRBlock* b, IROpcode op, int dest, int nargs) {
+    IRInstr* in = (IRInstr*)calloc(1, sizeof(IRInstr));
+    in->op = op;
+    in->dest = dest;
+    in->arg_count = nargs;
+    in->args = nargs > 0 ? (IROperand*)calloc(nargs, sizeof(IROperand)) : NULL;
+    in->block = b;
+    if (dest >= 0) fn->values[dest].def = in;
+    return in;
+}
+
+static IRInstr* add_instr(IRBlock* b, IROpcode op, int dest, int nargs) {
+    IRInstr* in = make_instr(b, op, dest, nargs);
+    GROW(b->instrs, b->instr_count, b->instr_cap);
+    b->instrs[b->instr_count++] = in;
+    return in;
+}
+
+static void free_instr(IRInstr* in) {
+    free(in->args);
+    free(in->name);
+    free(in);
+}
+
+// Komutu tek argumanli bir kopyaya cevir (dest korunur)
+static void make_copy(IRInstr* in, IROperand src) {
+    free(in->args);
+    in->op = IR_COPY;
+    in->args = (IROperand*)calloc(1, sizeof(IROperand));
+    in->args[0] = src;
+    in->arg_count = 1;
+}
+
+static void set_jump(IRBlock* b, IRBlock* target) {
+    if (b->term != TERM_NONE) return;
+    b->term = TERM_JMP;
+    b->succ[0] = target;
+}
+
+static void set_branch(IRBlock* b, IROperand cond, IRBlock* if_true, IRBlock* if_false) {
+    if (b->term != TERM_NONE) return;
+    b->term = TERM_BR;
+    b->cond = cond;
+    b->succ[0] = if_true;
+    b->succ[1] = if_false;
+}
+
+static int succ_count(IRBlock* b) {
+    if (b->term == TERM_BR || b->term == TERM_FOR) return 2;
+    return b->term == TERM_JMP ? 1 : 0;
+}
+
+// --- AST -> IR INDIRME ---
+
+static IRBinop binop_of(const char* op) {
+    if (strcmp(op, "+") == 0) return OP_ADD;
+    if (strcmp(op, "-") == 0) return OP_SUB;
+    if (strcmp(op, "*") == 0) return OP_MUL;
+    if (strcmp(op, "/") == 0) return OP_DIV;
+    if (strcmp(op, "%") == 0) return OP_MOD;
+    if (strcmp(op, "^") == 0) return OP_POW;
+    if (strcmp(op, ">") == 0) return OP_GT;
+    if (strcmp(op, "<") == 0) return OP_LT;
+    if (strcmp(op, "==") == 0) return OP_EQ;
+    return OP_NEQ;
+}
+
+static IROperand add_binop(IRBinop op, IROperand a, IROperand b) {
+    IRInstr* in = add_instr(cur, IR_BINOP, new_value(-1), 2);
+    in->binop = op;
+    in->args[0] = a;
+    in->args[1] = b;
+    return opd_value(in->dest);
+}
+
+static IROperand lower_expr(ASTNode* node);
+
+static int var_of(const char* name) {
+    int v = var_value(name); // fn->values buyuyebilir
+    return fn->values[v].var;
+}
+
+static IRInstr* add_mem_op(IROpcode op, const char* name, int var, int nargs) {
+    IRInstr* in = add_instr(cur, op, op == IR_MEM_READ ? new_value(-1) : -1, nargs);
+    in->name = strdup(name);
+    in->var = var;
+    return in;
+}
+
+// spawn hedefleri join'de VM tarafindan yazilir; SSA'ya alinmazlar, her
+// erisim isimli degisken uzerinden (LOAD / STORE) yapilir
+static ASTNode* func_body;
+
+static int is_task_var(ASTNode* node, const char* name) {
+    if (node == NULL) return 0;
+    if (node->type == NODE_SPAWN && node->id != NULL && strcmp(node->id, name) == 0) return 1;
+    return is_task_var(node->left, name) || is_task_var(node->right, name) ||
+           is_task_var(node->else_body, name) || is_task_var(node->next, name);
+}
+
+// Dizi degeri ureten ifadeyi (degisken ya da eleman bazinda islem) 'dst'
+// dizisine yazar
+static void lower_array_into(int dst, ASTNode* node) {
+    IRInstr* in;
+    if (node->type == NODE_BINOP) {
+        IROperand a = lower_expr(node->left);
+        IROperand b = lower_expr(node->right);
+        const char* op = node->id[0] == '+' ? "VADD" : node->id[0] == '-' ? "VSUB" : node->id[0] == '*' ? "VMUL" : "VDIV";
+        in = add_mem_op(IR_MEM_WRITE, op, dst, 2);
+        in->args[0] = a;
+        in->args[1] = b;
+    } else {
+        IROperand src = lower_expr(node);
+        in = add_mem_op(IR_MEM_WRITE, "VCOPY", dst, 1);
+        in->args[0] = src;
+    }
+}
+
+static IROperand lower_builtin(ASTNode* node) {
+    IROperand a = lower_expr(node->left);
+    int arr = fn->values[a.value].var;
+    IRInstr* in;
+    if (strcmp(node->id, "fill") == 0) {
+        IROperand v = lower_expr(node->left->next);
+        in = add_mem_op(IR_MEM_WRITE, "VFILL", arr, 1);
+        in->args[0] = v;
+        return opd_none();
+    }
+    if (strcmp(node->id, "dot") == 0) {
+        IROperand b = lower_expr(node->left->next);
+        in = add_mem_op(IR_MEM_READ, "VDOT", arr, 1);
+        in->args[0] = b;
+        return opd_value(in->dest);
+    }
+    const char* op = strcmp(node->id, "len") == 0 ? "ALEN" : strcmp(node->id, "sum") == 0 ? "VSUM" :
+                     strcmp(node->id, "min") == 0 ? "VMIN" : "VMAX";
+    in = add_mem_op(IR_MEM_READ, op, arr, 0);
+    return opd_value(in->dest);
+}
+
+static IROperand lower_expr(ASTNode* node) {
+    if (node == NULL) return opd_none();
+    switch (node->type) {
+        case NODE_NUM_INT: return opd_int(node->int_val);
+        case NODE_NUM_FLOAT: return opd_float(node->float_val);
+        case NODE_VAR:
+            if (is_task_var(func_body, node->id)) {
+                return opd_value(add_mem_op(IR_MEM_READ, "LOAD", var_of(node->id), 0)->dest);
+            }
+            return opd_value(var_value(node->id));
+
+        case NODE_INDEX: {
+            IROperand idx = lower_expr(node->left);
+            IRInstr* in = add_mem_op(IR_MEM_READ, "ALOAD", var_of(node->id), 1);
+            in->args[0] = idx;
+            return opd_value(in->dest);
+        }
+
+        case NODE_BUILTIN:
+            return lower_builtin(node);
+
+        case NODE_BINOP: {
+            if (IS_ARRAY_TYPE(node->data_type)) {
+                // Ara sonuc icin gecici dizi
+                char name[32];
+                snprintf(name, sizeof(name), "_v%d", fn->temp_count++);
+                int tmp = var_value(name);
+                lower_array_into(fn->values[tmp].var, node);
+                return opd_value(tmp);
+            }
+            IROperand a = lower_expr(node->left);
+            IROperand b = lower_expr(node->right);
+            return add_binop(binop_of(node->id), a, b);
+        }
+
+        case NODE_FUNC_CALL: {
+            int n = 0;
+            for (ASTNode* a = node->left; a != NULL; a = a->next) n++;
+            IROperand* args = (IROperand*)calloc(n > 0 ? n : 1, sizeof(IROperand));
+            int k = 0;
+            for (ASTNode* a = node->left; a != NULL; a = a->next) args[k++] = lower_expr(a);
+            IRInstr* in = add_instr(cur, IR_CALL, new_value(-1), n);
+            if (n > 0) memcpy(in->args, args, sizeof(IROperand) * n);
+            free(args);
+            in->name = strdup(node->id);
+            return opd_value(in->dest);
+        }
+
+        default:
+            return opd_none();
+    }
+}
+
+// Dongu boyunca sabit kalmasi gereken sinir: degiskense geciciye kopyalanir
+static IROperand snapshot(IROperand o) {
+    if (o.kind != OPD_VALUE || fn->values[o.value].var < 0) return o;
+    IRInstr* in = add_instr(cur, IR_COPY, new_value(-1), 1);
+    in->args[0] = o;
+    return opd_value(in->dest);
+}
+
+static void lower_stmt(ASTNode* node) {
+    IRBlock *then_b, *else_b, *join, *header, *body, *exit_b, *pre;
+    IROperand c, limit, step;
+    IRInstr* in;
+
+    switch (node->type) {
+        case NODE_BLOCK:
+            for (ASTNode* s = node->left; s != NULL; s = s->next) lower_stmt(s);
+            break;
+
+        case NODE_DECL:
+            if (IS_ARRAY_TYPE(node->data_type)) {
+                c = node->left ? lower_expr(node->left) : opd_int(0);
+                in = add_mem_op(IR_MEM_WRITE, node->data_type == TYPE_INT_ARRAY ? "NEWARR_INT" : "NEWARR_FLOAT",
+                                var_of(node->id), 1);
+                in->args[0] = c;
+                break;
+            }
+            in = add_instr(cur, IR_DECLARE, -1, 0);
+            in->name = strdup(node->id);
+            break;
+
+        case NODE_INDEX_ASSIGN: {
+            IROperand idx = lower_expr(node->left);
+            c = lower_expr(node->right);
+            in = add_mem_op(IR_MEM_WRITE, "ASTORE", var_of(node->id), 2);
+            in->args[0] = idx;
+            in->args[1] = c;
+            break;
+        }
+
+        case NODE_ASSIGN:
+            if (IS_ARRAY_TYPE(node->data_type)) {
+                lower_array_into(var_of(node->id), node->left);
+                break;
+            }
+            c = lower_expr(node->left);
+            if (is_task_var(func_body, node->id)) {
+                in = add_mem_op(IR_MEM_WRITE, "STORE", var_of(node->id), 1);
+            } else {
+                in = add_instr(cur, IR_COPY, var_value(node->id), 1);
+            }
+            in->args[0] = c;
+            break;
+
+        case NODE_SPAWN: {
+            int n = 0;
+            for (ASTNode* a = node->left->left; a != NULL; a = a->next) n++;
+            IROperand* args = (IROperand*)calloc(n > 0 ? n : 1, sizeof(IROperand));
+            int k = 0;
+            for (ASTNode* a = node->left->left; a != NULL; a = a->next) args[k++] = lower_expr(a);
+            in = add_instr(cur, IR_SPAWN, -1, n);
+            if (n > 0) memcpy(in->args, args, sizeof(IROperand) * n);
+            free(args);
+            in->name = strdup(node->left->id);
+            in->var = node->id ? var_of(node->id) : -1;
+            break;
+        }
+
+        case NODE_JOIN:
+            add_instr(cur, IR_JOIN, -1, 0);
+            break;
+
+        case NODE_READ:
+            in = add_instr(cur, IR_READ, var_value(node->id), 0);
+            in->name = strdup(node->data_type == TYPE_FLOAT ? "FLOAT" : "INT");
+            break;
+
+        case NODE_PRINT:
+            c = lower_expr(node->left);
+            in = add_instr(cur, IR_PRINT, -1, 1);
+            in->args[0] = c;
+            break;
+
+        case NODE_RETURN:
+            cur->cond = lower_expr(node->left);
+            cur->term = TERM_RET;
+            cur = new_block("BB"); // Sonrasi ulasilamaz, temizlenir
+            break;
+
+        case NODE_IF:
+            c = lower_expr(node->left);
+            then_b = new_block("BB");
+            else_b = node->else_body ? new_block("ELSE") : NULL;
+            join = new_block("EXIT");
+            set_branch(cur, c, then_b, else_b ? else_b : join);
+            cur = then_b;
+            lower_stmt(node->right);
+            set_jump(cur, join);
+            if (else_b) {
+                cur = else_b;
+                lower_stmt(node->else_body);
+                set_jump(cur, join);
+            }
+            cur = join;
+            break;
+
+        case NODE_UNLESS:
+            c = lower_expr(node->left);
+            body = new_block("BB");
+            join = new_block("SKIP");
+            set_branch(cur, c, join, body);
+            cur = body;
+            lower_stmt(node->right);
+            set_jump(cur, join);
+            cur = join;
+            break;
+
+        case NODE_WHILE:
+            header = new_block("START");
+            body = new_block("BB");
+            exit_b = new_block("END");
+            set_jump(cur, header);
+            cur = header;
+            c = lower_expr(node->left);
+            set_branch(cur, c, body, exit_b);
+            cur = body;
+            lower_stmt(node->right);
+            set_jump(cur, header);
+            cur = exit_b;
+            break;
+
+        case NODE_FOR: {
+            // Sinirlar bir kez hesaplanir. Baslangic ve adim sabitse ve
+            // a - s int'e sigiyorsa sayac (a - s) ile baslatilip dogrudan
+            // FOR_NEXT'e atlanir; giris testi de her tur da tek komuttur:
+            //   i := a - s; JMP F;  B: govde;  F: FOR_NEXT i b s B;  END:
+            // Aksi halde a - s 32 bitte sarabilir (for i := INT_MIN to 0 hic
+            // donmezdi); sayac a ile baslar ve giriste sinir bir kez denetlenir:
+            //   i := a; (i sinirin otesindeyse) JMP END;  B: govde;  F: ...
+            c = lower_expr(node->left);
+            limit = snapshot(lower_expr(node->left->next));
+            step = node->left->next->next ? snapshot(lower_expr(node->left->next->next)) : opd_int(1);
+            long long start = (long long)c.int_val - step.int_val;
+            int direct = c.kind == OPD_CONST && step.kind == OPD_CONST && step.int_val != 0 && start >= INT_MIN && start <= INT_MAX;
+            in = add_instr(cur, IR_COPY, var_value(node->id), 1);
+            in->args[0] = direct ? opd_int((int)start) : c;
+            IROperand counter = opd_value(var_value(node->id));
+            IROperand skip = opd_none(), zero = opd_none();
+            IRBlock* zero_pre = NULL;
+            if (direct) {
+                // Giris testi ilk FOR_NEXT'tedir
+            } else if (step.kind == OPD_CONST && step.int_val > 0) skip = add_binop(OP_LT, limit, counter);
+            else if (step.kind == OPD_CONST && step.int_val < 0) skip = add_binop(OP_LT, counter, limit);
+            else {
+                // Adim degiskense once s == 0 ise dogrudan FOR_NEXT'e gidilir
+                // (govde calismadan hata verir), sonra isaretine gore:
+                // (s > 0) * (b < i) + (s < 0) * (i < b).
+                zero = add_binop(OP_EQ, step, opd_int(0));
+                zero_pre = cur;
+                cur = new_block("BB");
+                IROperand up = add_binop(OP_MUL, add_binop(OP_GT, step, opd_int(0)), add_binop(OP_LT, limit, counter));
+                IROperand down = add_binop(OP_MUL, add_binop(OP_LT, step, opd_int(0)), add_binop(OP_LT, counter, limit));
+                skip = add_binop(OP_ADD, up, down);
+            }
+            pre = cur;
+            body = new_block("BB");
+            cur = body;
+            lower_stmt(node->right);
+            header = new_block("FOR");
+            set_jump(cur, header);
+            exit_b = new_block("END");
+            if (direct) set_jump(pre, header);
+            else set_branch(pre, skip, exit_b, body);
+            if (zero_pre) set_branch(zero_pre, zero, header, pre);
+            in = add_instr(header, IR_FOR_NEXT, var_value(node->id), 3);
+            in->args[0] = counter;
+            in->args[1] = limit;
+            in->args[2] = step;
+            header->term = TERM_FOR;
+            header->succ[0] = body;
+            header->succ[1] = exit_b;
+            cur = exit_b;
+            break;
+        }
+
+        default: // Ifade-ifadeleri (ornegin tek basina cagri)
+            lower_expr(node);
+            break;
+    }
+}
+
+// --- CFG ---
+
+static void add_pred(IRBlock* b, IRBlock* p) {
+    GROW(b->preds, b->pred_count, b->pred_cap);
+    b->preds[b->pred_count++] = p;
+}
+
+static void compute_preds() {
+    for (int i = 0; i < fn->block_count; i++) fn->blocks[i]->pred_count = 0;
+    for (int i = 0; i < fn->block_count; i++) {
+        IRBlock* b = fn->blocks[i];
+        for (int k = 0; k < succ_count(b); k++) add_pred(b->succ[k], b);
+    }
+}
+
+static void free_block(IRBlock* b) {
+    for (int i = 0; i < b->instr_count; i++) free_instr(b->instrs[i]);
+    free(b->instrs);
+    free(b->preds);
+    free(b->dom_children);
+    free(b->df);
+    free(b);
+}
+
+static void mark_reachable(IRBlock* b, char* seen) {
+    if (seen[b->id]) return;
+    seen[b->id] = 1;
+    for (int k = 0; k < succ_count(b); k++) mark_reachable(b->succ[k], seen);
+}
+
+static void remove_unreachable_blocks() {
+    char* seen = (char*)calloc(fn->block_count, 1);
+    mark_reachable(fn->blocks[0], seen);
+    int n = 0;
+    for (int i = 0; i < fn->block_count; i++) {
+        if (seen[i]) fn->blocks[n++] = fn->blocks[i];
+        else free_block(fn->blocks[i]);
+    }
+    fn->block_count = n;
+    for (int i = 0; i < n; i++) fn->blocks[i]->id = i;
+    free(seen);
+    compute_preds();
+}
+
+// Birden fazla cikisi olan bloktan birden fazla girisi olan bloga giden
+// kenarlara ara blok eklenir; SSA'dan cikarken kopyalar buraya konur.
+static void split_critical_edges() {
+    int n = fn->block_count;
+    for (int i = 0; i < n; i++) {
+        IRBlock* b = fn->blocks[i];
+        if (succ_count(b) < 2) continue;
+        for (int k = 0; k < 2; k++) {
+            if (b->succ[k]->pred_count < 2) continue;
+            IRBlock* mid = new_block("BB");
+            set_jump(mid, b->succ[k]);
+            b->succ[k] = mid;
+        }
+    }
+    compute_preds();
+}
+
+// --- BASKINLIK (DOMINATOR) ANALIZI ---
+// Cooper-Harvey-Kennedy yinelemeli algoritmasi.
+
+static IRBlock** rpo_order;
+static int rpo_count;
+
+static void postorder(IRBlock* b, char* seen) {
+    seen[b->id] = 1;
+    for (int k = 0; k < succ_count(b); k++) {
+        if (!seen[b->succ[k]->id]) postorder(b->succ[k], seen);
+    }
+    rpo_order[rpo_count++] = b;
+}
+
+static void compute_rpo() {
+    free(rpo_order);
+    rpo_order = (IRBlock**)malloc(sizeof(IRBlock*) * fn->block_count);
+    rpo_count = 0;
+    char* seen = (char*)calloc(fn->block_count, 1);
+    postorder(fn->blocks[0], seen);
+    free(seen);
+    for (int i = 0; i < rpo_count / 2; i++) {
+        IRBlock* t = rpo_order[i];
+        rpo_order[i] = rpo_order[rpo_count - 1 - i];
+        rpo_order[rpo_count - 1 - i] = t;
+    }
+    for (int i = 0; i < rpo_count; i++) rpo_order[i]->rpo = i;
+}
+
+static IRBlock* intersect(IRBlock* a, IRBlock* b) {
+    while (a != b) {
+        while (a->rpo > b->rpo) a = a->idom;
+        while (b->rpo > a->rpo) b = b->idom;
+    }
+    return a;
+}
+
+static void compute_dominators() {
+    compute_rpo();
+    for (int i = 0; i < fn->block_count; i++) {
+        IRBlock* b = fn->blocks[i];
+        b->idom = NULL;
+        b->dom_child_count = 0;
+        b->df_count = 0;
+    }
+    IRBlock* entry = fn->blocks[0];
+    entry->idom = entry;
+
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int i = 1; i < rpo_count; i++) {
+            IRBlock* b = rpo_order[i];
+            IRBlock* new_idom = NULL;
+            for (int p = 0; p < b->pred_count; p++) {
+                IRBlock* pred = b->preds[p];
+                if (pred->idom == NULL) continue;
+                new_idom = new_idom ? intersect(pred, new_idom) : pred;
+            }
+            if (new_idom != b->idom) {
+                b->idom = new_idom;
+                changed = 1;
+            }
+        }
+    }
+
+    for (int i = 1; i < rpo_count; i++) {
+        IRBlock* b = rpo_order[i];
+        IRBlock* d = b->idom;
+        GROW(d->dom_children, d->dom_child_count, d->dom_child_cap);
+        d->dom_children[d->dom_child_count++] = b;
+    }
+
+    // Baskinlik siniri
+    for (int i = 0; i < fn->block_count; i++) {
+        IRBlock* b = fn->blocks[i];
+        if (b->pred_count < 2) continue;
+        for (int p = 0; p < b->pred_count; p++) {
+            IRBlock* runner = b->preds[p];
+            while (runner != b->idom) {
+                int present = 0;
+                for (int k = 0; k < runner->df_count; k++) {
+                    if (runner->df[k] == b) present = 1;
+                }
+                if (!present) {
+                    GROW(runner->df, runner->df_count, runner->df_cap);
+                    runner->df[runner->df_count++] = b;
+                }
+                runner = runner->idom;
+            }
+        }
+    }
+}
+
+static int dominates(IRBlock* a, IRBlock* b) {
+    while (b != a) {
+        if (b->idom == b) return 0;
+        b = b->idom;
+    }
+    return 1;
+}
+
+// --- SSA INSASI ---
+
+static int defines_var(IRInstr* in, int var) {
+    return in->dest >= 0 && fn->values[in->dest].var == var && in->op != IR_PHI;
+}
+
+static void insert_phi(IRBlock* b, int var) {
+    IRInstr* phi = make_instr(b, IR_PHI, fn->var_base[var], b->pred_count);
+    for (int p = 0; p < b->pred_count; p++) phi->args[p] = opd_value(fn->var_base[var]);
+    GROW(b->instrs, b->instr_count, b->instr_cap);
+    memmove(&b->instrs[1], &b->instrs[0], sizeof(IRInstr*) * b->instr_count);
+    b->instrs[0] = phi;
+    b->instr_count++;
+}
+
+static void place_phis() {
+    int n = fn->block_count;
+    char* has_phi = (char*)malloc(n);
+    char* queued = (char*)malloc(n);
+    IRBlock** work = (IRBlock**)malloc(sizeof(IRBlock*) * n);
+
+    for (int v = 0; v < fn->var_count; v++) {
+        memset(has_phi, 0, n);
+        memset(queued, 0, n);
+        int top = 0;
+        for (int i = 0; i < n; i++) {
+            IRBlock* b = fn->blocks[i];
+            for (int k = 0; k < b->instr_count; k++) {
+                if (defines_var(b->instrs[k], v)) { work[top++] = b; queued[i] = 1; break; }
+            }
+        }
+        while (top > 0) {
+            IRBlock* b = work[--top];
+            for (int k = 0; k < b->df_count; k++) {
+                IRBlock* d = b->df[k];
+                if (has_phi[d->id]) continue;
+                insert_phi(d, v);
+                has_phi[d->id] = 1;
+                if (!queued[d->id]) { queued[d->id] = 1; work[top++] = d; }
+            }
+        }
+    }
+    free(has_phi);
+    free(queued);
+    free(work);
+}
+
+static int** rename_stack;
+static int* rename_sp;
+
+static int stack_top(int var) {
+    return rename_sp[var] > 0 ? rename_stack[var][rename_sp[var] - 1] : fn->var_base[var];
+}
+
+static void stack_push(int var, int v) {
+    rename_stack[var] = realloc(rename_stack[var], sizeof(int) * (rename_sp[var] + 1));
+    rename_stack[var][rename_sp[var]++] = v;
+}
+
+static IROperand rename_use(IROperand o) {
+    if (o.kind == OPD_VALUE && is_var_base(o.value)) o.value = stack_top(fn->values[o.value].var);
+    return o;
+}
+
+static void rename_block(IRBlock* b) {
+    int* pushed = (int*)calloc(fn->var_count > 0 ? fn->var_count : 1, sizeof(int));
+
+    for (int i = 0; i < b->instr_count; i++) {
+        IRInstr* in = b->instrs[i];
+        if (in->op != IR_PHI) {
+            for (int k = 0; k < in->arg_count; k++) in->args[k] = rename_use(in->args[k]);
+        }
+        if (in->dest >= 0 && is_var_base(in->dest)) {
+            int var = fn->values[in->dest].var;
+            int v = new_value(var);
+            in->dest = v;
+            fn->values[v].def = in;
+            stack_push(var, v);
+            pushed[var]++;
+        }
+    }
+    b->cond = rename_use(b->cond);
+
+    for (int k = 0; k < succ_count(b); k++) {
+        IRBlock* s = b->succ[k];
+        for (int p = 0; p < s->pred_count; p++) {
+            if (s->preds[p] != b) continue;
+            for (int i = 0; i < s->instr_count && s->instrs[i]->op == IR_PHI; i++) {
+                IRInstr* phi = s->instrs[i];
+                phi->args[p] = opd_value(stack_top(fn->values[phi->dest].var));
+            }
+        }
+    }
+
+    for (int c = 0; c < b->dom_child_count; c++) rename_block(b->dom_children[c]);
+
+    for (int v = 0; v < fn->var_count; v++) rename_sp[v] -= pushed[v];
+    free(pushed);
+}
+
+static void build_ssa() {
+    compute_dominators();
+    place_phis();
+    rename_stack = (int**)calloc(fn->var_count > 0 ? fn->var_count : 1, sizeof(int*));
+    rename_sp = (int*)calloc(fn->var_count > 0 ? fn->var_count : 1, sizeof(int));
+    rename_block(fn->blocks[0]);
+    for (int v = 0; v < fn->var_count; v++) free(rename_stack[v]);
+    free(rename_stack);
+    free(rename_sp);
+}
+
+// --- YARDIMCI GEZINTILER ---
+
+static void count_uses() {
+    for (int v = 0; v < fn->value_count; v++) fn->values[v].uses = 0;
+    for (int i = 0; i < fn->block_count; i++) {
+        IRBlock* b = fn->blocks[i];
+        for (int k = 0; k < b->instr_count; k++) {
+            IRInstr* in = b->instrs[k];
+            if (in->dead) continue;
+            for (int a = 0; a < in->arg_count; a++) {
+                if (in->args[a].kind == OPD_VALUE) fn->values[in->args[a].value].uses++;
+            }
+        }
+        if (b->cond.kind == OPD_VALUE) fn->values[b->cond.value].uses++;
+    }
+}
+
+static void compact_block(IRBlock* b) {
+    int n = 0;
+    for (int k = 0; k < b->instr_count; k++) {
+        IRInstr* in = b->instrs[k];
+        if (!in->dead) { b->instrs[n++] = in; continue; }
+        if (in->dest >= 0 && fn->values[in->dest].def == in) fn->values[in->dest].def = NULL;
+        free_instr(in);
+    }
+    b->instr_count = n;
+}
+
+// --- SABIT KATLAMA ---
+// VM ile ayni aritmetik; katlanamazsa 0 doner.
+
+static int fold_ir_binop(IRBinop op, IROperand a, IROperand b, IROperand* out) {
+    if (a.kind != OPD_CONST || b.kind != OPD_CONST || a.type != b.type) return 0;
+    if (a.type == TYPE_INT) {
+        int x = a.int_val, y = b.int_val;
+        switch (op) {
+            case OP_ADD: *out = opd_int((int)((unsigned int)x + (unsigned int)y)); return 1;
+            case OP_SUB: *out = opd_int((int)((unsigned int)x - (unsigned int)y)); return 1;
+            case OP_MUL: *out = opd_int((int)((unsigned int)x * (unsigned int)y)); return 1;
+            case OP_DIV: if (y == 0) return 0; *out = opd_int(y == -1 ? (int)(0u - (unsigned int)x) : x / y); return 1;
+            case OP_MOD: if (y == 0) return 0; *out = opd_int(y == -1 ? 0 : x % y); return 1;
+            case OP_POW: *out = opd_int((int)pow(x, y)); return 1;
+            case OP_GT: *out = opd_int(x > y); return 1;
+            case OP_LT: *out = opd_int(x < y); return 1;
+            case OP_EQ: *out = opd_int(x == y); return 1;
+            case OP_NEQ: *out = opd_int(x != y); return 1;
+        }
+        return 0;
+    }
+    float x = a.float_val, y = b.float_val;
+    switch (op) {
+        case OP_ADD: *out = opd_float(x + y); return 1;
+        case OP_SUB: *out = opd_float(x - y); return 1;
+        case OP_MUL: *out = opd_float(x * y); return 1;
+        case OP_DIV: *out = opd_float(x / y); return 1;
+        case OP_POW: *out = opd_float(powf(x, y)); return 1;
+        case OP_GT: *out = opd_int(x > y); return 1;
+        case OP_LT: *out = opd_int(x < y); return 1;
+        case OP_EQ: *out = opd_int(x == y); return 1;
+        case OP_NEQ: *out = opd_int(x != y); return 1;
+        default: return 0; // Float % VM'de int'e cevrilir
+    }
+}
+
+static int is_commutative(IRBinop op) {
+    return op == OP_ADD || op == OP_MUL || op == OP_EQ || op == OP_NEQ;
+}
+
+// --- GLOBAL DEGER NUMARALANDIRMA (GVN / CSE) ---
+// Baskinlik agaci uzerinde kapsamli bir ifade tablosu tutulur: bir blokta
+// hesaplanan ifade, baskin oldugu bloklarda tekrar hesaplanmaz. Ifadenin
+// lideri her zaman gecici bir degerdir, boylece SSA'dan cikista kaynak
+// degiskenlerin yasam araliklari cakismaz.
+
+typedef struct {
+    IRBinop op;
+    IROperand a, b;
+    int leader;
+} ExprEntry;
+
+static ExprEntry* expr_table;
+static int expr_count, expr_cap;
+static IROperand* value_number;
+
+static IROperand canon(IROperand o) {
+    return o.kind == OPD_VALUE ? value_number[o.value] : o;
+}
+
+// Degismeli islemlerde islenen sirasini sabitle
+static int operand_order(IROperand o) {
+    return o.kind == OPD_VALUE ? o.value : -1 - (o.type == TYPE_INT ? o.int_val & 0xffff : 0);
+}
+
+static void gvn_block(IRBlock* b) {
+    int mark = expr_count;
+
+    for (int i = 0; i < b->instr_count; i++) {
+        IRInstr* in = b->instrs[i];
+        if (in->dead || in->dest < 0) continue;
+        value_number[in->dest] = opd_value(in->dest);
+
+        if (in->op == IR_COPY) {
+            value_number[in->dest] = canon(in->args[0]);
+        } else if (in->op == IR_PHI) {
+            // Tum argumanlari ayni olan phi o degerin kendisidir
+            IROperand first = canon(in->args[0]);
+            int same = first.kind != OPD_NONE && !(first.kind == OPD_VALUE && first.value == in->dest);
+            for (int k = 1; k < in->arg_count && same; k++) {
+                if (!same_operand(canon(in->args[k]), first)) same = 0;
+            }
+            if (same && first.kind == OPD_VALUE) value_number[in->dest] = first;
+        } else if (in->op == IR_BINOP) {
+            IROperand a = canon(in->args[0]);
+            IROperand c = canon(in->args[1]);
+            IROperand folded;
+            if (fold_ir_binop(in->binop, a, c, &folded)) {
+                make_copy(in, folded);
+                value_number[in->dest] = folded;
+                continue;
+            }
+            if (is_commutative(in->binop) && operand_order(a) > operand_order(c)) {
+                IROperand t = a; a = c; c = t;
+            }
+            int found = -1;
+            for (int k = expr_count - 1; k >= 0 && found < 0; k--) {
+                if (expr_table[k].op == in->binop && same_operand(expr_table[k].a, a) &&
+                    same_operand(expr_table[k].b, c)) found = expr_table[k].leader;
+            }
+            if (found >= 0) {
+                make_copy(in, opd_value(found));
+                value_number[in->dest] = opd_value(found);
+            } else {
+                GROW(expr_table, expr_count, expr_cap);
+                expr_table[expr_count].op = in->binop;
+                expr_table[expr_count].a = a;
+                expr_table[expr_count].b = c;
+                expr_table[expr_count].leader = in->dest;
+                expr_count++;
+            }
+        }
+    }
+
+    for (int c = 0; c < b->dom_child_count; c++) gvn_block(b->dom_children[c]);
+    expr_count = mark;
+}
+
+static void global_value_numbering() {
+    value_number = (IROperand*)malloc(sizeof(IROperand) * fn->value_count);
+    for (int v = 0; v < fn->value_count; v++) value_number[v] = opd_value(v);
+    expr_count = 0;
+    gvn_block(fn->blocks[0]);
+    free(value_number);
+    free(expr_table);
+    expr_table = NULL;
+    expr_cap = 0;
+}
+
+// --- KOPYA YAYILIMI ---
+// Kaynagi gecici deger ya da sabit olan kopyalarin hedefi, kullanildigi her
+// yerde kaynakla degistirilir. Kaynak bir degiskense kopya korunur (ayni
+// degiskenin iki surumu ayni anda canli kalmasin diye).
+
+static IROperand* replacement;
+static char* has_replacement;
+
+static IROperand resolve(IROperand o) {
+    int guard = 0;
+    while (o.kind == OPD_VALUE && has_replacement[o.value] && guard++ < fn->value_count) {
+        o = replacement[o.value];
+    }
+    return o;
+}
+
+static void copy_propagation() {
+    replacement = (IROperand*)malloc(sizeof(IROperand) * fn->value_count);
+    has_replacement = (char*)calloc(fn->value_count, 1);
+
+    for (int i = 0; i < fn->block_count; i++) {
+        IRBlock* b = fn->blocks[i];
+        for (int k = 0; k < b->instr_count; k++) {
+            IRInstr* in = b->instrs[k];
+            if (in->dead || in->op != IR_COPY) continue;
+            IROperand src = in->args[0];
+            if (src.kind == OPD_CONST || (src.kind == OPD_VALUE && fn->values[src.value].var < 0)) {
+                replacement[in->dest] = src;
+                has_replacement[in->dest] = 1;
+            }
+        }
+    }
+
+    for (int i = 0; i < fn->block_count; i++) {
+        IRBlock* b = fn->blocks[i];
+        for (int k = 0; k < b->instr_count; k++) {
+            IRInstr* in = b->instrs[k];
+            // FOR_NEXT sayaci VM'de isimle okur: args[0] sayacin surumu
+            // olarak kalmali ki ona yapilan atama (i := a - s) silinmesin
+            for (int a = in->op == IR_FOR_NEXT ? 1 : 0; a < in->arg_count; a++) in->args[a] = resolve(in->args[a]);
+        }
+        b->cond = resolve(b->cond);
+    }
+
+    free(replacement);
+    free(has_replacement);
+}
+
+// --- DONGUDEN BAGIMSIZ KOD TASIMA (LICM) ---
+// Geri kenar (b -> h, h b'ye baskin) dogal bir dongu tanimlar. Islenenleri
+// donguden bagimsiz olan aritmetik islemler dongu on blogunun (preheader)
+// sonuna tasinir. DIV/MOD sifira bolmede VM'i durdurabilecegi icin tasinmaz;
+// digerleri dongu hic calismasa bile guvenlidir.
+
+static int block_in(char* set, IRBlock* b) { return set[b->id]; }
+
+static void collect_loop(IRBlock* header, IRBlock* latch, char* in_loop) {
+    IRBlock** work = (IRBlock**)malloc(sizeof(IRBlock*) * fn->block_count);
+    int top = 0;
+    in_loop[header->id] = 1;
+    if (!in_loop[latch->id]) { in_loop[latch->id] = 1; work[top++] = latch; }
+    while (top > 0) {
+        IRBlock* b = work[--top];
+        for (int p = 0; p < b->pred_count; p++) {
+            IRBlock* pred = b->preds[p];
+            if (!in_loop[pred->id]) { in_loop[pred->id] = 1; work[top++] = pred; }
+        }
+    }
+    free(work);
+}
+
+static int is_invariant(IROperand o, char* in_loop) {
+    if (o.kind != OPD_VALUE) return 1;
+    IRInstr* def = fn->values[o.value].def;
+    return def == NULL || def->dead || !block_in(in_loop, def->block);
+}
+
+static int hoist_loop(IRBlock* header, char* in_loop) {
+    IRBlock* pre = NULL;
+    for (int p = 0; p < header->pred_count; p++) {
+        IRBlock* pred = header->preds[p];
+        if (block_in(in_loop, pred)) continue;
+        if (pre != NULL) return 0; // Tek on blok yok
+        pre = pred;
+    }
+    if (pre == NULL || succ_count(pre) != 1) return 0;
+
+    int moved = 0, changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int r = 0; r < rpo_count; r++) {
+            IRBlock* b = rpo_order[r];
+            if (!block_in(in_loop, b)) continue;
+            for (int k = 0; k < b->instr_count; k++) {
+                IRInstr* in = b->instrs[k];
+                if (in->dead || in->op != IR_BINOP || fn->values[in->dest].var >= 0) continue;
+                if (in->binop == OP_DIV || in->binop == OP_MOD) continue;
+                if (!is_invariant(in->args[0], in_loop) || !is_invariant(in->args[1], in_loop)) continue;
+
+                memmove(&b->instrs[k], &b->instrs[k + 1], sizeof(IRInstr*) * (b->instr_count - k - 1));
+                b->instr_count--;
+                k--;
+                GROW(pre->instrs, pre->instr_count, pre->instr_cap);
+                pre->instrs[pre->instr_count++] = in;
+                in->block = pre;
+                moved++;
+                changed = 1;
+            }
+        }
+    }
+    return moved;
+}
+
+static void loop_invariant_code_motion() {
+    char* in_loop = (char*)malloc(fn->block_count);
+    // Ic donguler once: baslik RPO sirasina gore sondan basa
+    for (int r = rpo_count - 1; r >= 0; r--) {
+        IRBlock* h = rpo_order[r];
+        memset(in_loop, 0, fn->block_count);
+        int is_header = 0;
+        for (int p = 0; p < h->pred_count; p++) {
+            if (dominates(h, h->preds[p])) {
+                collect_loop(h, h->preds[p], in_loop);
+                is_header = 1;
+            }
+        }
+        if (is_header) hoist_loop(h, in_loop);
+    }
+    free(in_loop);
+}
+
+// --- OLU KOD ELEME ---
+
+static void mark_live(IROperand o, IRInstr*** work, int* top, int* cap) {
+    if (o.kind != OPD_VALUE) return;
+    IRInstr* def = fn->values[o.value].def;
+    if (def == NULL || !def->dead) return;
+    def->dead = 0;
+    GROW(*work, *top, *cap);
+    (*work)[(*top)++] = def;
+}
+
+// Sonucu kullanilmasa da silinmemeli: sifira bolme, dizi siniri, bos
+// dizide min/max, boyut uyusmazligi calisma aninda hata verir
+static int may_trap(IRInstr* in) {
+    if (in->op == IR_MEM_READ) return strcmp(in->name, "ALEN") != 0 && strcmp(in->name, "VSUM") != 0 && strcmp(in->name, "LOAD") != 0;
+    if (in->op != IR_BINOP || (in->binop != OP_DIV && in->binop != OP_MOD)) return 0;
+    IROperand d = in->args[1];
+    if (d.kind != OPD_CONST) return 1;
+    if (d.type == TYPE_FLOAT) return in->binop == OP_MOD && (int)d.float_val == 0; // Float mod int'e cevrilir
+    return d.int_val == 0;
+}
+
+static void dead_code_elimination() {
+    IRInstr** work = NULL;
+    int top = 0, cap = 0;
+
+    for (int i = 0; i < fn->block_count; i++) {
+        IRBlock* b = fn->blocks[i];
+        for (int k = 0; k < b->instr_count; k++) {
+            IRInstr* in = b->instrs[k];
+            int critical = in->op == IR_CALL || in->op == IR_PRINT || in->op == IR_READ ||
+                           in->op == IR_DECLARE || in->op == IR_FOR_NEXT || in->op == IR_MEM_WRITE ||
+                           in->op == IR_SPAWN || in->op == IR_JOIN || may_trap(in);
+            in->dead = !critical;
+            if (critical) { GROW(work, top, cap); work[top++] = in; }
+        }
+    }
+    for (int i = 0; i < fn->block_count; i++) mark_live(fn->blocks[i]->cond, &work, &top, &cap);
+    while (top > 0) {
+        IRInstr* in = work[--top];
+        for (int a = 0; a < in->arg_count; a++) mark_live(in->args[a], &work, &top, &cap);
+    }
+    free(work);
+    for (int i = 0; i < fn->block_count; i++) compact_block(fn->blocks[i]);
+}
+
+// --- SSA'DAN CIKIS ---
+// Degerler kaynak degisken adlarina geri eslenir. Phi'ler, ongel bloklarin
+// sonuna konan kopyalarla degistirilir (kritik kenarlar bolundugu icin her
+// ongelin tek cikisi vardir). Baska bir degiskenin surumu olan argumanlar
+// once geciciye alinir ki siralama ayni bloktaki atamalarla karismasin.
+
+static int same_name(IROperand o, int dest) {
+    return o.kind == OPD_VALUE && fn->values[o.value].var >= 0 &&
+           fn->values[o.value].var == fn->values[dest].var;
+}
+
+static void append_copy(IRBlock* b, int dest, IROperand src) {
+    IRInstr* in = add_instr(b, IR_COPY, dest, 1);
+    in->args[0] = src;
+}
+
+// Tek kullanimlik gecici deger ongelde hesaplaniyorsa ve ondan sonra hedef
+// degisken okunmuyorsa, komut sonucu dogrudan degiskene yazar (x := x + 1
+// icin STORE _t / LOAD _t / STORE x yerine STORE x).
+static int retarget_def(IRBlock* pred, IROperand src, int dest) {
+    if (src.kind != OPD_VALUE || fn->values[src.value].var >= 0 || fn->values[src.value].uses != 1) return 0;
+    IRInstr* def = fn->values[src.value].def;
+    if (def == NULL || def->block != pred || def->op == IR_PHI) return 0;
+    int var = fn->values[dest].var;
+    int after = 0;
+    for (int k = 0; k < pred->instr_count; k++) {
+        IRInstr* in = pred->instrs[k];
+        if (in == def) { after = 1; continue; }
+        if (!after) continue;
+        for (int a = 0; a < in->arg_count; a++) {
+            if (in->args[a].kind == OPD_VALUE && fn->values[in->args[a].value].var == var) return 0;
+        }
+    }
+    def->dest = dest;
+    return 1;
+}
+
+static void leave_ssa() {
+    count_uses();
+    for (int i = 0; i < fn->block_count; i++) {
+        IRBlock* b = fn->blocks[i];
+        if (b->instr_count == 0 || b->instrs[0]->op != IR_PHI) continue;
+        for (int p = 0; p < b->pred_count; p++) {
+            IRBlock* pred = b->preds[p];
+            // 1. adim: baska degiskenlerden gelenleri geciciye al
+            IROperand* srcs = (IROperand*)malloc(sizeof(IROperand) * b->instr_count);
+            for (int k = 0; k < b->instr_count && b->instrs[k]->op == IR_PHI; k++) {
+                IRInstr* phi = b->instrs[k];
+                srcs[k] = phi->args[p];
+                if (srcs[k].kind == OPD_VALUE && fn->values[srcs[k].value].var >= 0 && !same_name(srcs[k], phi->dest)) {
+                    int t = new_value(-1);
+                    append_copy(pred, t, srcs[k]);
+                    srcs[k] = opd_value(t);
+                }
+            }
+            // 2. adim: atamalar
+            for (int k = 0; k < b->instr_count && b->instrs[k]->op == IR_PHI; k++) {
+                IRInstr* phi = b->instrs[k];
+                if (same_name(srcs[k], phi->dest)) continue;
+                if (retarget_def(pred, srcs[k], phi->dest)) continue;
+                append_copy(pred, phi->dest, srcs[k]);
+            }
+            free(srcs);
+        }
+        for (int k = 0; k < b->instr_count && b->instrs[k]->op == IR_PHI; k++) b->instrs[k]->dead = 1;
+        compact_block(b);
+    }
+}
+
+// --- PUBLIC ---
+
+IRFunction* ir_build(ASTNode* func) {
+    fn = (IRFunction*)calloc(1, sizeof(IRFunction));
+    fn->name = strdup(func->id);
+    fn->is_main = strcmp(func->id, "main") == 0;
+    for (ASTNode* p = func->left; p != NULL; p = p->next) var_value(p->id);
+    func_body = func->right;
+
+    cur = new_block("BB");
+    if (func->right) lower_stmt(func->right);
+    if (cur->term == TERM_NONE) {
+        cur->term = TERM_RET;
+        cur->cond = opd_none();
+    }
+    compute_preds();
+    remove_unreachable_blocks();
+    split_critical_edges();
+    return fn;
+}
+
+void ir_optimize(IRFunction* f) {
+    fn = f;
+    build_ssa();
+    global_value_numbering();
+    copy_propagation();
+    dead_code_elimination();
+    loop_invariant_code_motion();
+    global_value_numbering(); // Tasinan ifadeler artik ortak olabilir
+    copy_propagation();
+    dead_code_elimination();
+    leave_ssa();
+}
+
+// --- BYTECODE URETIMI ---
+
+static FILE* ir_out;
+static int pending = -1; // Yiginda duran, henuz STORE edilmemis gecici deger
+
+static void print_value_name(int v) {
+    if (fn->values[v].var >= 0) fprintf(ir_out, "%s", fn->vars[fn->values[v].var]);
+    else fprintf(ir_out, "_t%d", fn->values[v].num);
+}
+
+static void flush_pending() {
+    if (pending < 0) return;
+    fprintf(ir_out, "STORE ");
+    print_value_name(pending);
+    fprintf(ir_out, "\n");
+    pending = -1;
+}
+
+static void load_operand(IROperand o) {
+    if (o.kind == OPD_CONST) {
+        if (o.type == TYPE_INT) fprintf(ir_out, "PUSH_INT %d\n", o.int_val);
+        else fprintf(ir_out, "PUSH_FLOAT %f\n", o.float_val);
+    } else if (o.kind == OPD_VALUE) {
+        fprintf(ir_out, "LOAD ");
+        print_value_name(o.value);
+        fprintf(ir_out, "\n");
+    }
+}
+
+// Komutun ilk islenini yigina koyar: zaten yigindaysa yeniden yuklenmez
+static void load_first(IROperand o) {
+    if (o.kind == OPD_VALUE && o.value == pending) { pending = -1; return; }
+    flush_pending();
+    load_operand(o);
+}
+
+// Komutun argumanlarini sirayla yigina koyar
+static void load_args(IRInstr* in) {
+    if (in->arg_count == 0) { flush_pending(); return; }
+    load_first(in->args[0]);
+    for (int a = 1; a < in->arg_count; a++) load_operand(in->args[a]);
+}
+
+static void store_result(int dest) {
+    if (fn->values[dest].var < 0 && fn->values[dest].uses == 1) { pending = dest; return; }
+    if (fn->values[dest].var < 0 && fn->values[dest].uses == 0) return; // Kullanilmayan cagri sonucu
+    fprintf(ir_out, "STORE ");
+    print_value_name(dest);
+    fprintf(ir_out, "\n");
+}
+
+static const char* binop_name(IRBinop op) {
+    static const char* names[] = {"ADD", "SUB", "MUL", "DIV", "MOD", "POW", "GT", "LT", "EQ", "NEQ"};
+    return names[op];
+}
+
+static void emit_instr(IRInstr* in) {
+    switch (in->op) {
+        case IR_BINOP: {
+            IRBinop op = in->binop;
+            IROperand a = in->args[0], b = in->args[1];
+            // Ikinci islen yigindaysa ve islem yer degistirebiliyorsa yeniden yukleme
+            if (b.kind == OPD_VALUE && b.value == pending && !(a.kind == OPD_VALUE && a.value == pending) &&
+                (is_commutative(op) || op == OP_GT || op == OP_LT)) {
+                pending = -1;
+                load_operand(a);
+                if (op == OP_GT) op = OP_LT;
+                else if (op == OP_LT) op = OP_GT;
+            } else {
+                load_first(a);
+                load_operand(b);
+            }
+            fprintf(ir_out, "%s\n", binop_name(op));
+            store_result(in->dest);
+            break;
+        }
+        case IR_COPY:
+            if (same_name(in->args[0], in->dest)) break;
+            load_first(in->args[0]);
+            fprintf(ir_out, "STORE ");
+            print_value_name(in->dest);
+            fprintf(ir_out, "\n");
+            break;
+        case IR_CALL:
+            load_args(in);
+            fprintf(ir_out, "CALL FUNC_%s\n", in->name);
+            store_result(in->dest);
+            break;
+        case IR_PRINT:
+            load_first(in->args[0]);
+            fprintf(ir_out, "PRINT\n");
+            break;
+        case IR_READ:
+            flush_pending();
+            fprintf(ir_out, "READ ");
+            print_value_name(in->dest);
+            fprintf(ir_out, " %s\n", in->name);
+            break;
+        case IR_DECLARE:
+            flush_pending();
+            fprintf(ir_out, "DECLARE %s\n", in->name);
+            break;
+        case IR_PHI:
+            break;
+        case IR_FOR_NEXT: // Sonlandirici ile birlikte yazilir
+            flush_pending();
+            break;
+        case IR_MEM_READ:
+        case IR_MEM_WRITE:
+            load_args(in);
+            fprintf(ir_out, "%s %s\n", in->name, fn->vars[in->var]);
+            if (in->op == IR_MEM_READ) store_result(in->dest);
+            break;
+        case IR_SPAWN:
+            load_args(in);
+            fprintf(ir_out, "SPAWN FUNC_%s %d %s\n", in->name, in->arg_count, in->var >= 0 ? fn->vars[in->var] : "-");
+            break;
+        case IR_JOIN:
+            flush_pending();
+            fprintf(ir_out, "JOIN\n");
+            break;
+    }
+}
+
+// Bos ve sadece atlayan bloklari atla
+static IRBlock* thread(IRBlock* b) {
+    int guard = 0;
+    while (b != fn->blocks[0] && b->instr_count == 0 && b->term == TERM_JMP && guard++ < fn->block_count) {
+        b = b->succ[0];
+    }
+    return b;
+}
+
+static int skipped(IRBlock* b) {
+    return thread(b) != b;
+}
+
+static IRBlock* next_in_layout(int i) {
+    for (int k = i + 1; k < fn->block_count; k++) {
+        if (!skipped(fn->blocks[k])) return fn->blocks[k];
+    }
+    return NULL;
+}
+
+static void need_label(IRBlock* b) {
+    if (b->label < 0) b->label = 0;
+}
+
+static void print_label_ref(IRBlock* b) {
+    fprintf(ir_out, "LABEL_%s_%d", b->kind, b->label);
+}
+
+// Komut argumani olarak: sabit ya da degisken adi
+static void print_operand_ref(IROperand o) {
+    if (o.kind == OPD_CONST) fprintf(ir_out, "%d", o.int_val);
+    else print_value_name(o.value);
+}
+
+static void emit_terminator(IRBlock* b, IRBlock* next, int dry_run) {
+    IRBlock *t, *f;
+    switch (b->term) {
+        case TERM_JMP:
+            t = thread(b->succ[0]);
+            if (t == next) { if (!dry_run) flush_pending(); break; }
+            if (dry_run) { need_label(t); break; }
+            flush_pending();
+            fprintf(ir_out, "JMP "); print_label_ref(t); fprintf(ir_out, "\n");
+            break;
+        case TERM_BR:
+            t = thread(b->succ[0]);
+            f = thread(b->succ[1]);
+            if (dry_run) {
+                if (t == next) need_label(f);
+                else if (f == next) need_label(t);
+                else { need_label(f); need_label(t); }
+                break;
+            }
+            load_first(b->cond);
+            if (t == next) {
+                fprintf(ir_out, "JZ "); print_label_ref(f); fprintf(ir_out, "\n");
+            } else if (f == next) {
+                fprintf(ir_out, "JNZ "); print_label_ref(t); fprintf(ir_out, "\n");
+            } else {
+                fprintf(ir_out, "JZ "); print_label_ref(f); fprintf(ir_out, "\n");
+                fprintf(ir_out, "JMP "); print_label_ref(t); fprintf(ir_out, "\n");
+            }
+            break;
+        case TERM_FOR: {
+            // FOR_NEXT i limit adim GOVDE: i += adim, sinir asilmadiysa govdeye
+            IRInstr* fin = b->instrs[b->instr_count - 1];
+            t = thread(b->succ[0]);
+            f = thread(b->succ[1]);
+            if (dry_run) {
+                need_label(t);
+                if (f != next) need_label(f);
+                break;
+            }
+            flush_pending();
+            fprintf(ir_out, "FOR_NEXT ");
+            print_value_name(fin->dest);
+            fprintf(ir_out, " ");
+            print_operand_ref(fin->args[1]);
+            fprintf(ir_out, " ");
+            print_operand_ref(fin->args[2]);
+            fprintf(ir_out, " ");
+            print_label_ref(t);
+            fprintf(ir_out, "\n");
+            if (f != next) { fprintf(ir_out, "JMP "); print_label_ref(f); fprintf(ir_out, "\n"); }
+            break;
+        }
+        case TERM_RET:
+            if (dry_run) break;
+            if (fn->is_main) {
+                // main'in donus degeri kullanilmaz; program durur
+                if (b->cond.kind == OPD_VALUE && b->cond.value == pending) pending = -1;
+                flush_pending();
+            } else if (b->cond.kind != OPD_NONE) {
+                load_first(b->cond);
+            } else {
+                flush_pending();
+            }
+            fprintf(ir_out, fn->is_main ? "HALT\n" : "RETURN\n");
+            break;
+        case TERM_NONE:
+            break;
+    }
+}
+
+void ir_emit(IRFunction* f, FILE* out) {
+    fn = f;
+    ir_out = out;
+    pending = -1;
+    count_uses();
+    int label_count = 0; // Etiketler fonksiyona yerel; link_function kaydirir
+
+    // 1. tur: hangi bloklarin etikete ihtiyaci var
+    for (int i = 0; i < fn->block_count; i++) fn->blocks[i]->label = -1;
+    for (int i = 0; i < fn->block_count; i++) {
+        IRBlock* b = fn->blocks[i];
+        if (!skipped(b)) emit_terminator(b, next_in_layout(i), 1);
+    }
+    for (int i = 0; i < fn->block_count; i++) {
+        if (fn->blocks[i]->label >= 0) fn->blocks[i]->label = label_count++;
+    }
+
+    // 2. tur: kod
+    for (int i = 0; i < fn->block_count; i++) {
+        IRBlock* b = fn->blocks[i];
+        if (skipped(b)) continue;
+        if (b->label >= 0) {
+            print_label_ref(b);
+            fprintf(ir_out, ":\n");
+        }
+        for (int k = 0; k < b->instr_count; k++) emit_instr(b->instrs[k]);
+        emit_terminator(b, next_in_layout(i), 0);
+    }
+    flush_pending();
+}
+
+void ir_free(IRFunction* f) {
+    for (int i = 0; i < f->block_count; i++) free_block(f->blocks[i]);
+    free(f->blocks);
+    free(f->values);
+    for (int v = 0; v < f->var_count; v++) free(f->vars[v]);
+    free(f->vars);
+    free(f->var_base);
+    free(f->name);
+    free(f);
+    free(rpo_order);
+    rpo_order = NULL;
+}
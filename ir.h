@@ -0,0 +1,108 @@
+#ifndef IR_H
+#define IR_H
+#include <stdio.h>
+#include "ast.h"
+
+// --- ARA GOSTERIM (IR) ---
+// Her fonksiyon temel bloklara (basic block) indirilir; bloklar kontrol
+// akis grafini (CFG) olusturur. Degiskenler SSA formuna cevrilir, optimize
+// edilir, sonra SSA'dan cikilip yigin (stack) bytecode'u uretilir.
+
+typedef enum {
+    IR_COPY,     // dest = a
+    IR_BINOP,    // dest = a op b
+    IR_CALL,     // dest = name(args...)
+    IR_PRINT,    // print(a)
+    IR_READ,     // dest = read()
+    IR_DECLARE,  // VM'de degisken tanimi (name)
+    IR_PHI,      // dest = phi(ongel basina bir arguman)
+    IR_FOR_NEXT, // dest = a + adim; bitis siniri asilmadiysa dongu devam (blogun son komutu)
+    // Isimli degisken komutlari: name VM komutu, var degisken, argumanlar
+    // yigina sirayla konur. Diziler ve spawn hedefleri SSA'ya girmez; sadece
+    // bu komutlarla erisilir.
+    IR_MEM_READ,  // dest = ALOAD / ALEN / VSUM / VMIN / VMAX / VDOT / LOAD
+    IR_MEM_WRITE, // NEWARR_* / ASTORE / VADD.. / VCOPY / VFILL / STORE (yan etkili)
+    IR_SPAWN,     // name(args...) gorev olarak baslatilir; sonuc join'de var'a yazilir
+    IR_JOIN       // Cercevenin gorevlerini bekle
+} IROpcode;
+
+typedef enum {
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MOD, OP_POW,
+    OP_GT, OP_LT, OP_EQ, OP_NEQ
+} IRBinop;
+
+typedef enum { OPD_NONE, OPD_VALUE, OPD_CONST } OperandKind;
+
+typedef struct {
+    OperandKind kind;
+    int value;      // OPD_VALUE: deger indeksi
+    DataType type;  // OPD_CONST
+    int int_val;
+    float float_val;
+} IROperand;
+
+struct IRBlock;
+
+typedef struct IRInstr {
+    IROpcode op;
+    IRBinop binop;
+    int dest;              // Tanimlanan deger, yoksa -1
+    IROperand* args;
+    int arg_count;
+    char* name;            // CALL / SPAWN: fonksiyon adi, DECLARE: degisken adi, READ: tip (INT / FLOAT),
+                           // isimli komutlar: VM komutu
+    int var;               // Isimli komutlar ve SPAWN: degisken indeksi (SPAWN'da yoksa -1)
+    struct IRBlock* block;
+    int dead;
+} IRInstr;
+
+typedef enum { TERM_NONE, TERM_JMP, TERM_BR, TERM_RET, TERM_FOR } IRTermKind;
+
+typedef struct IRBlock {
+    int id;
+    const char* kind;          // Etiket adi: START, END, ELSE, EXIT, SKIP, BB
+    IRInstr** instrs;
+    int instr_count, instr_cap;
+    IRTermKind term;
+    IROperand cond;            // TERM_BR kosulu ya da TERM_RET degeri
+    struct IRBlock* succ[2];   // TERM_BR: succ[0] kosul dogruysa, succ[1] yanlissa
+                               // TERM_FOR: succ[0] govde, succ[1] donguden cikis
+    struct IRBlock** preds;
+    int pred_count, pred_cap;
+
+    // Analiz bilgileri
+    int rpo;
+    struct IRBlock* idom;
+    struct IRBlock** dom_children;
+    int dom_child_count, dom_child_cap;
+    struct IRBlock** df;       // Baskinlik siniri (dominance frontier)
+    int df_count, df_cap;
+    int label;                 // Emisyonda etiket numarasi, yoksa -1
+} IRBlock;
+
+typedef struct {
+    int var;        // Kaynak degisken indeksi; gecici degerler icin -1
+    int num;        // Gecici deger numarasi (_tN)
+    IRInstr* def;   // Tanimlayan komut; giriste gelen degerler icin NULL
+    int uses;
+} IRValue;
+
+typedef struct {
+    char* name;
+    int is_main;
+    IRBlock** blocks;
+    int block_count, block_cap;
+    IRValue* values;
+    int value_count, value_cap;
+    char** vars;          // Kaynak degisken isimleri
+    int* var_base;        // Degiskenin SSA oncesi (ve giristeki) degeri
+    int var_count, var_cap;
+    int temp_count;
+} IRFunction;
+
+IRFunction* ir_build(ASTNode* func);
+void ir_optimize(IRFunction* fn);
+void ir_emit(IRFunction* fn, FILE* out); // Etiket numaralari 0'dan baslar
+void ir_free(IRFunction* fn);
+
+#endif
@@ -0,0 +1,805 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "compiler.h"
+#include "optimizer.h"
+
+#define SPECIALIZE_BUDGET 2000   // Klonlanabilecek toplam dugum sayisi (kod boyutu siniri)
+#define SPECIALIZE_MAX_BODY 200  // Bundan buyuk govdeler klonlanmaz
+#define MAX_SPECS 64
+
+// --- YARDIMCI FONKSIYONLAR ---
+
+static int is_literal(ASTNode* node) {
+    return node != NULL && (node->type == NODE_NUM_INT || node->type == NODE_NUM_FLOAT);
+}
+
+// Dugumu ve cocuklarini serbest birakir (next zincirine dokunmaz)
+static void discard(ASTNode* node) {
+    if (node == NULL) return;
+    node->next = NULL;
+    free_ast(node);
+}
+
+// Dugumu yerinde bir sabite donustur
+static void make_int(ASTNode* node, int val) {
+    discard(node->left); discard(node->right); discard(node->else_body);
+    if (node->id) free(node->id);
+    node->id = NULL; node->left = node->right = node->else_body = NULL;
+    node->type = NODE_NUM_INT; node->data_type = TYPE_INT; node->int_val = val;
+}
+
+static void make_float(ASTNode* node, float val) {
+    discard(node->left); discard(node->right); discard(node->else_body);
+    if (node->id) free(node->id);
+    node->id = NULL; node->left = node->right = node->else_body = NULL;
+    node->type = NODE_NUM_FLOAT; node->data_type = TYPE_FLOAT; node->float_val = val;
+}
+
+static int is_int_const(ASTNode* node, int val) {
+    return node != NULL && node->type == NODE_NUM_INT && node->int_val == val;
+}
+
+static int is_float_const(ASTNode* node, float val) {
+    return node != NULL && node->type == NODE_NUM_FLOAT && node->float_val == val;
+}
+
+static int is_const_value(ASTNode* node, int val) {
+    return is_int_const(node, val) || is_float_const(node, (float)val);
+}
+
+static int count_nodes(ASTNode* node) {
+    if (node == NULL) return 0;
+    return 1 + count_nodes(node->left) + count_nodes(node->right) +
+           count_nodes(node->else_body) + count_nodes(node->next);
+}
+
+static int calls_function(ASTNode* node, const char* name) {
+    if (node == NULL) return 0;
+    if (node->type == NODE_FUNC_CALL && strcmp(node->id, name) == 0) return 1;
+    return calls_function(node->left, name) || calls_function(node->right, name) ||
+           calls_function(node->else_body, name) || calls_function(node->next, name);
+}
+
+// Degisken govdede yaziliyor ya da yeniden tanimlaniyor mu?
+static int writes_var(ASTNode* node, const char* name) {
+    if (node == NULL) return 0;
+    if ((node->type == NODE_ASSIGN || node->type == NODE_READ || node->type == NODE_DECL ||
+         node->type == NODE_FOR || node->type == NODE_INDEX_ASSIGN || node->type == NODE_SPAWN) &&
+        node->id != NULL && strcmp(node->id, name) == 0) return 1;
+    return writes_var(node->left, name) || writes_var(node->right, name) ||
+           writes_var(node->else_body, name) || writes_var(node->next, name);
+}
+
+// 'name' okumalarini sabit ile degistir. Arguman ve for siniri zincirleri
+// next ile bagli oldugundan degistirilen dugumden sonra da devam edilir.
+static void substitute_var(ASTNode* node, const char* name, ASTNode* lit) {
+    if (node == NULL) return;
+    if (node->type == NODE_VAR && strcmp(node->id, name) == 0) {
+        if (lit->type == NODE_NUM_INT) make_int(node, lit->int_val);
+        else make_float(node, lit->float_val);
+        substitute_var(node->next, name, lit);
+        return;
+    }
+    substitute_var(node->left, name, lit);
+    substitute_var(node->right, name, lit);
+    substitute_var(node->else_body, name, lit);
+    substitute_var(node->next, name, lit);
+}
+
+static ASTNode* find_func_decl(ASTNode* program, const char* name) {
+    for (ASTNode* f = program->left; f != NULL; f = f->next) {
+        if (f->type == NODE_FUNC_DECL && strcmp(f->id, name) == 0) return f;
+    }
+    return NULL;
+}
+
+// --- SABIT KATLAMA (CONSTANT FOLDING) ---
+// Sonuclar VM'deki hesapla ayni olmali (tamsayi ^ icin (int)pow, float icin powf).
+// Tamsayi + - * 32 bit sarar; INT_MIN / -1 de VM'deki gibi sarar (% -1 -> 0).
+
+static int fold_binop(ASTNode* node) {
+    ASTNode* l = node->left;
+    ASTNode* r = node->right;
+    const char* op = node->id;
+
+    if (l->type == NODE_NUM_INT && r->type == NODE_NUM_INT) {
+        int a = l->int_val, b = r->int_val;
+        if (strcmp(op, "+") == 0) make_int(node, (int)((unsigned int)a + (unsigned int)b));
+        else if (strcmp(op, "-") == 0) make_int(node, (int)((unsigned int)a - (unsigned int)b));
+        else if (strcmp(op, "*") == 0) make_int(node, (int)((unsigned int)a * (unsigned int)b));
+        else if (strcmp(op, "/") == 0 && b == -1) make_int(node, (int)(0u - (unsigned int)a));
+        else if (strcmp(op, "%") == 0 && b == -1) make_int(node, 0);
+        else if (strcmp(op, "/") == 0 && b != 0) make_int(node, a / b);
+        else if (strcmp(op, "%") == 0 && b != 0) make_int(node, a % b);
+        else if (strcmp(op, "^") == 0) make_int(node, (int)pow(a, b));
+        else if (strcmp(op, ">") == 0) make_int(node, a > b);
+        else if (strcmp(op, "<") == 0) make_int(node, a < b);
+        else if (strcmp(op, "==") == 0) make_int(node, a == b);
+        else if (strcmp(op, "!=") == 0) make_int(node, a != b);
+        else return 0;
+        return 1;
+    }
+    if (l->type == NODE_NUM_FLOAT && r->type == NODE_NUM_FLOAT) {
+        float a = l->float_val, b = r->float_val;
+        if (strcmp(op, "+") == 0) make_float(node, a + b);
+        else if (strcmp(op, "-") == 0) make_float(node, a - b);
+        else if (strcmp(op, "*") == 0) make_float(node, a * b);
+        else if (strcmp(op, "/") == 0) make_float(node, a / b);
+        else if (strcmp(op, "^") == 0) make_float(node, powf(a, b));
+        else if (strcmp(op, ">") == 0) make_int(node, a > b);
+        else if (strcmp(op, "<") == 0) make_int(node, a < b);
+        else if (strcmp(op, "==") == 0) make_int(node, a == b);
+        else if (strcmp(op, "!=") == 0) make_int(node, a != b);
+        else return 0; // Float % VM'de int'e cevrilir, katlama
+        return 1;
+    }
+    return 0;
+}
+
+// Dugum yerine cocugunu koy
+static ASTNode* take_child(ASTNode* node, ASTNode* child) {
+    if (node->left == child) node->left = NULL;
+    else node->right = NULL;
+    discard(node);
+    return child;
+}
+
+static ASTNode* fold_expr(ASTNode* node);
+
+static void fold_args(ASTNode* call) {
+    ASTNode** link = &call->left;
+    while (*link != NULL) {
+        ASTNode* next = (*link)->next;
+        (*link)->next = NULL;
+        ASTNode* folded = fold_expr(*link);
+        folded->next = next;
+        *link = folded;
+        link = &folded->next;
+    }
+}
+
+static ASTNode* fold_expr(ASTNode* node) {
+    if (node == NULL) return NULL;
+    if (node->type == NODE_FUNC_CALL || node->type == NODE_BUILTIN) { fold_args(node); return node; }
+    if (node->type == NODE_INDEX) { node->left = fold_expr(node->left); return node; }
+    if (node->type != NODE_BINOP) return node;
+
+    node->left = fold_expr(node->left);
+    node->right = fold_expr(node->right);
+    ASTNode* l = node->left;
+    ASTNode* r = node->right;
+    const char* op = node->id;
+
+    if (is_literal(l) && is_literal(r) && fold_binop(node)) return node;
+
+    // Dizi islemi yeni bir dizi uretir; a + 0 -> a olursa cagrilan fonksiyon
+    // cagiranin dizisini degistirebilir
+    if (IS_ARRAY_TYPE(node->data_type) || IS_ARRAY_TYPE(l->data_type) || IS_ARRAY_TYPE(r->data_type)) return node;
+
+    // Cebirsel sadelestirmeler (tip degismeyen durumlar). Float'ta x + 0.0
+    // -0.0'i +0.0 yapar, sadelestirilmez
+    if (strcmp(op, "+") == 0) {
+        if (is_int_const(r, 0)) return take_child(node, l);
+        if (is_int_const(l, 0)) return take_child(node, r);
+    } else if (strcmp(op, "-") == 0 || strcmp(op, "/") == 0) {
+        if (is_const_value(r, op[0] == '-' ? 0 : 1)) return take_child(node, l);
+    } else if (strcmp(op, "*") == 0) {
+        if (is_const_value(r, 1)) return take_child(node, l);
+        if (is_const_value(l, 1)) return take_child(node, r);
+    } else if (strcmp(op, "^") == 0) {
+        if (is_int_const(r, 1) || is_float_const(r, 1.0f)) return take_child(node, l);
+        // x ^ 2 -> x * x (degisken okumasi yan etkisiz). Yalnizca float:
+        // tamsayida tasan (int)pow ile sarmali carpim farkli sonuc verir
+        if (is_float_const(r, 2.0f) && l->type == NODE_VAR) {
+            free(node->id);
+            node->id = strdup("*");
+            discard(r);
+            node->right = clone_ast(l);
+            return node;
+        }
+    }
+    return node;
+}
+
+static ASTNode* fold_stmt(ASTNode* node);
+
+static ASTNode* fold_stmt_list(ASTNode* stmt) {
+    ASTNode* head = NULL;
+    ASTNode** link = &head;
+    while (stmt != NULL) {
+        ASTNode* next = stmt->next;
+        stmt->next = NULL;
+        ASTNode* folded = fold_stmt(stmt);
+        if (folded != NULL) {
+            *link = folded;
+            link = &folded->next;
+        }
+        stmt = next;
+    }
+    return head;
+}
+
+// Tek bir ifadeyi katlar; sabit kosullu dallar secilen govdeyle
+// degistirilir, hic calismayacak olanlar NULL doner.
+static ASTNode* fold_stmt(ASTNode* node) {
+    if (node == NULL) return NULL;
+    ASTNode* taken;
+
+    switch (node->type) {
+        case NODE_BLOCK:
+            node->left = fold_stmt_list(node->left);
+            return node;
+
+        case NODE_ASSIGN:
+        case NODE_PRINT:
+        case NODE_RETURN:
+        case NODE_DECL:
+        case NODE_SPAWN:
+            node->left = fold_expr(node->left);
+            return node;
+
+        case NODE_INDEX_ASSIGN:
+            node->left = fold_expr(node->left);
+            node->right = fold_expr(node->right);
+            return node;
+
+        case NODE_IF:
+        case NODE_UNLESS:
+            node->left = fold_expr(node->left);
+            node->right = fold_stmt(node->right);
+            node->else_body = fold_stmt(node->else_body);
+            if (node->left->type != NODE_NUM_INT) return node;
+            if ((node->left->int_val != 0) == (node->type == NODE_IF)) {
+                taken = node->right; node->right = NULL;
+            } else {
+                taken = node->else_body; node->else_body = NULL;
+            }
+            discard(node);
+            return taken;
+
+        case NODE_WHILE:
+            node->left = fold_expr(node->left);
+            node->right = fold_stmt(node->right);
+            if (is_int_const(node->left, 0)) { discard(node); return NULL; }
+            return node;
+
+        case NODE_FOR: {
+            fold_args(node); // baslangic -> bitis -> adim zinciri
+            node->right = fold_stmt(node->right);
+            // Sabit sinirlarla hic donmeyecekse sadece sayac atamasi kalir
+            ASTNode* from = node->left;
+            ASTNode* to = from->next;
+            ASTNode* step = to->next;
+            int st = step ? step->int_val : 1;
+            if (from->type != NODE_NUM_INT || to->type != NODE_NUM_INT || (step && step->type != NODE_NUM_INT)) return node;
+            if (st == 0 || (st > 0 ? from->int_val <= to->int_val : from->int_val >= to->int_val)) return node;
+            taken = create_assign(node->id, create_int(from->int_val, node->line), node->line);
+            discard(node);
+            return taken;
+        }
+
+        case NODE_BINOP:
+        case NODE_FUNC_CALL:
+        case NODE_BUILTIN:
+            return fold_expr(node);
+
+        default:
+            return node;
+    }
+}
+
+ASTNode* fold_constants(ASTNode* stmt) {
+    return fold_stmt(stmt);
+}
+
+// --- FONKSIYONLAR ARASI SABIT YAYILIMI VE OZELLESTIRME ---
+// power(x, 2) gibi sabit argumanli cagrilar icin, sabit parametreleri
+// govdeye gomulmus bir kopya (power__2) uretilir ve katlanir. Ayni
+// (fonksiyon, sabitler) cifti tek bir kopyayi paylasir.
+
+typedef struct {
+    char func[32];
+    unsigned int mask;                 // Sabitlenen parametrelerin bitleri
+    ASTNode* values[MAX_PARAMS];       // Sabit degerler (literal kopyalari)
+    char clone[32];
+} Specialization;
+
+static Specialization specs[MAX_SPECS];
+static int spec_count = 0;
+static int spec_used = 0; // Harcanan dugum butcesi
+
+static int same_literal(ASTNode* a, ASTNode* b) {
+    if (a->type != b->type) return 0;
+    if (a->type == NODE_NUM_INT) return a->int_val == b->int_val;
+    return a->float_val == b->float_val;
+}
+
+static Specialization* find_spec(const char* func, unsigned int mask, ASTNode** values) {
+    for (int i = 0; i < spec_count; i++) {
+        if (strcmp(specs[i].func, func) != 0 || specs[i].mask != mask) continue;
+        int same = 1;
+        for (int k = 0; k < MAX_PARAMS && same; k++) {
+            if ((mask & (1u << k)) && !same_literal(specs[i].values[k], values[k])) same = 0;
+        }
+        if (same) return &specs[i];
+    }
+    return NULL;
+}
+
+// power + {2} -> "power__2", 1.5 -> "1p5"; isim cok uzunsa ya da
+// kullaniliyorsa sira numarasina duser.
+static void mangle_name(char* out, const char* func, unsigned int mask, ASTNode** values) {
+    char buf[128];
+    int len = snprintf(buf, sizeof(buf), "%s_", func);
+    for (int k = 0; k < MAX_PARAMS; k++) {
+        if (!(mask & (1u << k))) continue;
+        char val[32];
+        if (values[k]->type == NODE_NUM_INT) snprintf(val, sizeof(val), "%d", values[k]->int_val);
+        else snprintf(val, sizeof(val), "%g", values[k]->float_val);
+        for (char* c = val; *c; c++) {
+            if (*c == '.') *c = 'p';
+            else if (*c == '-') *c = 'm';
+            else if (*c == '+') *c = '_';
+        }
+        len += snprintf(buf + len, sizeof(buf) - len, "_%s", val);
+        if (len >= (int)sizeof(buf)) break;
+    }
+    for (int n = spec_count; strlen(buf) > 26 || lookup_function(buf) != -1; n++) {
+        snprintf(buf, sizeof(buf), "%.16s__s%d", func, n);
+    }
+    strcpy(out, buf);
+}
+
+static Specialization* create_spec(ASTNode* callee, unsigned int mask, ASTNode** values) {
+    int size = count_nodes(callee->right);
+    if (size > SPECIALIZE_MAX_BODY || spec_used + size > SPECIALIZE_BUDGET) return NULL;
+    if (spec_count >= MAX_SPECS || func_count >= MAX_FUNCS) return NULL;
+
+    Specialization* sp = &specs[spec_count];
+    strcpy(sp->func, callee->id);
+    sp->mask = mask;
+    for (int k = 0; k < MAX_PARAMS; k++) {
+        sp->values[k] = (mask & (1u << k)) ? clone_ast(values[k]) : NULL;
+    }
+    mangle_name(sp->clone, callee->id, mask, values);
+    spec_count++;
+    spec_used += size;
+
+    // Sabit olmayan parametreler kalir
+    ASTNode* params = NULL;
+    ASTNode** plink = &params;
+    ASTNode* body = clone_ast(callee->right);
+    int k = 0;
+    for (ASTNode* p = callee->left; p != NULL; p = p->next, k++) {
+        if (mask & (1u << k)) {
+            substitute_var(body, p->id, values[k]);
+        } else {
+            *plink = create_param(p->id, p->data_type, p->line);
+            plink = &(*plink)->next;
+        }
+    }
+
+    ASTNode* clone = create_func_decl(sp->clone, callee->data_type, params, body, callee->line);
+    clone->memo = callee->memo;
+    clone->right = fold_constants(clone->right);
+    // Listenin sonuna eklenir; specialize_functions donusu kopyayi da tarar
+    ASTNode* last = callee;
+    while (last->next != NULL) last = last->next;
+    last->next = clone;
+
+    add_function(sp->clone, callee->data_type, callee->line);
+    FunctionSymbol* fs = &func_table[func_count - 1];
+    fs->memo_annotated = callee->memo;
+    for (ASTNode* p = params; p != NULL; p = p->next) {
+        fs->param_types[fs->param_count++] = p->data_type;
+    }
+    return sp;
+}
+
+static int try_specialize(ASTNode* program, ASTNode* call) {
+    ASTNode* callee = find_func_decl(program, call->id);
+    if (callee == NULL || strcmp(callee->id, "main") == 0) return 0;
+    // Ozyinelemeli fonksiyonlar her seviyede yeni bir kopya dogurur ve
+    // memo onbellegini boler; bunlar genel halleriyle kalir.
+    if (calls_function(callee->right, callee->id)) return 0;
+
+    unsigned int mask = 0;
+    ASTNode* values[MAX_PARAMS] = {0};
+    ASTNode* p = callee->left;
+    ASTNode* a = call->left;
+    for (int k = 0; p != NULL && a != NULL && k < MAX_PARAMS; p = p->next, a = a->next, k++) {
+        if (is_literal(a) && !writes_var(callee->right, p->id)) {
+            mask |= 1u << k;
+            values[k] = a;
+        }
+    }
+    if (mask == 0) return 0;
+
+    Specialization* sp = find_spec(callee->id, mask, values);
+    if (sp == NULL) sp = create_spec(callee, mask, values);
+    if (sp == NULL) return 0;
+
+    // Cagriyi kopyaya yonlendir, sabit argumanlari dusur
+    free(call->id);
+    call->id = strdup(sp->clone);
+    ASTNode* args = NULL;
+    ASTNode** link = &args;
+    a = call->left;
+    for (int k = 0; a != NULL; k++) {
+        ASTNode* next = a->next;
+        a->next = NULL;
+        if (k < MAX_PARAMS && (mask & (1u << k))) {
+            discard(a);
+        } else {
+            *link = a;
+            link = &a->next;
+        }
+        a = next;
+    }
+    call->left = args;
+    return 1;
+}
+
+static int specialize_calls(ASTNode* program, ASTNode* node) {
+    if (node == NULL) return 0;
+    int n = specialize_calls(program, node->left) + specialize_calls(program, node->right) +
+            specialize_calls(program, node->else_body) + specialize_calls(program, node->next);
+    if (node->type == NODE_FUNC_CALL) n += try_specialize(program, node);
+    return n;
+}
+
+int specialize_functions(ASTNode* program) {
+    int count = 0;
+    // Yeni kopyalar listeye eklendikce onlar da taranir (zincirleme yayilim)
+    for (ASTNode* f = program->left; f != NULL; f = f->next) {
+        if (f->type == NODE_FUNC_DECL) count += specialize_calls(program, f->right);
+    }
+    return count;
+}
+
+// --- OLU KOD ELEME ---
+
+static int removed_stmts = 0;
+
+// Ifade her yolda return ile bitiyor mu?
+static int always_returns(ASTNode* node) {
+    if (node == NULL) return 0;
+    switch (node->type) {
+        case NODE_RETURN: return 1;
+        case NODE_BLOCK:
+            for (ASTNode* s = node->left; s != NULL; s = s->next) {
+                if (always_returns(s)) return 1;
+            }
+            return 0;
+        case NODE_IF: return always_returns(node->right) && always_returns(node->else_body);
+        default: return 0;
+    }
+}
+
+// return'den sonra gelen (asla calismayacak) ifadeleri sil
+static void remove_unreachable(ASTNode* stmt) {
+    for (; stmt != NULL; stmt = stmt->next) {
+        if (stmt->type == NODE_BLOCK) remove_unreachable(stmt->left);
+        else if (stmt->type == NODE_IF || stmt->type == NODE_UNLESS || stmt->type == NODE_WHILE ||
+                 stmt->type == NODE_FOR) {
+            if (stmt->right) remove_unreachable(stmt->right->left);
+            if (stmt->else_body) remove_unreachable(stmt->else_body->left);
+        }
+        if (always_returns(stmt) && stmt->next != NULL) {
+            for (ASTNode* s = stmt->next; s != NULL; s = s->next) removed_stmts++;
+            free_ast(stmt->next);
+            stmt->next = NULL;
+        }
+    }
+}
+
+// --- CANLILIK (LIVENESS) ANALIZI ---
+// Degiskenler isimle takip edilir; VM de bir cagri cercevesindeki ayni
+// isimli degiskenleri tek bir yuva olarak tutar, bu yuzden bu model VM ile
+// birebir uyumludur. Kume, fonksiyondaki isimlerin indeksleri uzerinde bir
+// bit kumesidir.
+
+#define MAX_LIVE_VARS 128
+
+typedef struct { unsigned long long bits[MAX_LIVE_VARS / 64]; } VarSet;
+
+static char* live_names[MAX_LIVE_VARS];
+static int live_name_count;
+
+static int var_index(const char* name) {
+    for (int i = 0; i < live_name_count; i++) {
+        if (strcmp(live_names[i], name) == 0) return i;
+    }
+    if (live_name_count >= MAX_LIVE_VARS) return -1;
+    live_names[live_name_count] = (char*)name;
+    return live_name_count++;
+}
+
+// Fonksiyondaki tum isimleri indeksle; sigmazsa 0 doner
+static int collect_names(ASTNode* node) {
+    if (node == NULL) return 1;
+    if ((node->type == NODE_VAR || node->type == NODE_ASSIGN || node->type == NODE_READ ||
+         node->type == NODE_DECL || node->type == NODE_PARAM || node->type == NODE_FOR ||
+         node->type == NODE_INDEX || node->type == NODE_INDEX_ASSIGN || node->type == NODE_SPAWN) &&
+        node->id != NULL && var_index(node->id) == -1) return 0;
+    return collect_names(node->left) && collect_names(node->right) &&
+           collect_names(node->else_body) && collect_names(node->next);
+}
+
+static void set_add(VarSet* s, const char* name) {
+    int i = var_index(name);
+    s->bits[i / 64] |= 1ULL << (i % 64);
+}
+
+static void set_remove(VarSet* s, const char* name) {
+    int i = var_index(name);
+    s->bits[i / 64] &= ~(1ULL << (i % 64));
+}
+
+static int set_has(VarSet* s, const char* name) {
+    int i = var_index(name);
+    return (s->bits[i / 64] >> (i % 64)) & 1;
+}
+
+static VarSet set_union(VarSet a, VarSet b) {
+    for (int k = 0; k < MAX_LIVE_VARS / 64; k++) a.bits[k] |= b.bits[k];
+    return a;
+}
+
+static int set_equal(VarSet a, VarSet b) {
+    return memcmp(&a, &b, sizeof(VarSet)) == 0;
+}
+
+// Ifadede okunan degiskenleri ekle
+static void add_uses(VarSet* s, ASTNode* expr) {
+    if (expr == NULL) return;
+    if (expr->type == NODE_VAR) { set_add(s, expr->id); return; }
+    if (expr->type == NODE_INDEX) { set_add(s, expr->id); add_uses(s, expr->left); return; }
+    if (expr->type == NODE_FUNC_CALL || expr->type == NODE_BUILTIN) {
+        for (ASTNode* a = expr->left; a != NULL; a = a->next) add_uses(s, a);
+        return;
+    }
+    add_uses(s, expr->left);
+    add_uses(s, expr->right);
+}
+
+static int has_call(ASTNode* expr) {
+    if (expr == NULL) return 0;
+    if (expr->type == NODE_FUNC_CALL) return 1;
+    return has_call(expr->left) || has_call(expr->right) || has_call(expr->next);
+}
+
+// Calisma aninda hata verebilecek ifade (sifira bolme, dizi siniri, bos
+// dizide min/max, boyut uyusmazligi): sonucu kullanilmasa da silinmez
+static int may_trap(ASTNode* expr) {
+    if (expr == NULL) return 0;
+    if (expr->type == NODE_INDEX) return 1;
+    if (expr->type == NODE_BUILTIN && strcmp(expr->id, "len") != 0 && strcmp(expr->id, "sum") != 0) return 1;
+    if (expr->type == NODE_BINOP) {
+        if (IS_ARRAY_TYPE(expr->left->data_type) && IS_ARRAY_TYPE(expr->right->data_type)) return 1;
+        int int_div = strcmp(expr->id, "%") == 0 || (strcmp(expr->id, "/") == 0 && ELEMENT_TYPE(expr->data_type) == TYPE_INT);
+        if (int_div && !(expr->right->type == NODE_NUM_INT && expr->right->int_val != 0)) return 1;
+    }
+    return may_trap(expr->left) || may_trap(expr->right) || may_trap(expr->next);
+}
+
+static VarSet live_list(ASTNode** link, VarSet out, int apply);
+
+// 'out' kumesinden geriye dogru 'in' kumesini hesaplar. Olu atamalar
+// silinmis gibi hesaplanir; apply=1 ise *dead ile isaretlenir ve cagiran
+// liste onlari siler (dongu sabit noktasi ararken apply=0).
+static VarSet live_stmt(ASTNode* node, VarSet out, int apply, int* dead) {
+    VarSet in = out;
+    VarSet empty;
+    memset(&empty, 0, sizeof(empty));
+
+    switch (node->type) {
+        case NODE_INDEX_ASSIGN:
+            // Dizi parametreleri cagiranin dizisini gosterir: eleman ve
+            // tum-dizi atamalari hic silinmez, diziyi de oldurmez.
+            set_add(&in, node->id);
+            add_uses(&in, node->left);
+            add_uses(&in, node->right);
+            return in;
+
+        case NODE_ASSIGN:
+            if (IS_ARRAY_TYPE(node->data_type)) {
+                set_add(&in, node->id);
+                add_uses(&in, node->left);
+                return in;
+            }
+            if (dead != NULL && !set_has(&out, node->id) && !has_call(node->left) && !may_trap(node->left)) {
+                if (apply) *dead = 1;
+                return out;
+            }
+            set_remove(&in, node->id);
+            add_uses(&in, node->left);
+            return in;
+
+        case NODE_READ:
+            set_remove(&in, node->id);
+            return in;
+
+        case NODE_RETURN:
+            // Donusten sonra cercevenin tum yerelleri olur
+            in = empty;
+            add_uses(&in, node->left);
+            return in;
+
+        case NODE_BLOCK:
+            return live_list(&node->left, out, apply);
+
+        case NODE_IF:
+        case NODE_UNLESS: {
+            VarSet t = live_stmt(node->right, out, apply, dead);
+            VarSet e = node->else_body ? live_stmt(node->else_body, out, apply, dead) : out;
+            in = set_union(t, e);
+            add_uses(&in, node->left);
+            return in;
+        }
+
+        case NODE_WHILE: {
+            // Dongu basindaki canli kume sabit noktaya ulasana kadar
+            VarSet head = out;
+            add_uses(&head, node->left);
+            for (;;) {
+                VarSet body = live_stmt(node->right, head, 0, dead);
+                VarSet next = set_union(out, body);
+                add_uses(&next, node->left);
+                if (set_equal(next, head)) break;
+                head = next;
+            }
+            if (apply) live_stmt(node->right, head, 1, dead);
+            return head;
+        }
+
+        case NODE_FOR: {
+            // Sayac her turda FOR_NEXT tarafindan okunur; govdede yazilamaz
+            VarSet head = out;
+            set_add(&head, node->id);
+            for (;;) {
+                VarSet next = set_union(head, live_stmt(node->right, head, 0, dead));
+                if (set_equal(next, head)) break;
+                head = next;
+            }
+            if (apply) live_stmt(node->right, head, 1, dead);
+            in = head;
+            set_remove(&in, node->id);
+            for (ASTNode* e = node->left; e != NULL; e = e->next) add_uses(&in, e);
+            return in;
+        }
+
+        default: // print, ifade-ifadeleri, decl, spawn, join
+            // spawn hedefi join'de yazilir; o zamana kadar eski deger
+            // okunabilecegi icin hedef burada oldurulmez.
+            add_uses(&in, node);
+            return in;
+    }
+}
+
+static VarSet live_list(ASTNode** link, VarSet out, int apply) {
+    ASTNode* node = *link;
+    if (node == NULL) return out;
+    VarSet after = live_list(&node->next, out, apply);
+    int dead = 0;
+    VarSet in = live_stmt(node, after, apply, &dead);
+    if (dead) {
+        *link = node->next;
+        discard(node);
+        removed_stmts++;
+    }
+    return in;
+}
+
+static int references_var(ASTNode* node, const char* name) {
+    if (node == NULL) return 0;
+    if ((node->type == NODE_VAR || node->type == NODE_ASSIGN || node->type == NODE_READ ||
+         node->type == NODE_FOR || node->type == NODE_INDEX || node->type == NODE_INDEX_ASSIGN ||
+         node->type == NODE_SPAWN) && node->id != NULL && strcmp(node->id, name) == 0) return 1;
+    return references_var(node->left, name) || references_var(node->right, name) ||
+           references_var(node->else_body, name) || references_var(node->next, name);
+}
+
+// Hic kullanilmayan yerellerin DECL ifadelerini sil
+static void remove_unused_decls(ASTNode** link, ASTNode* body) {
+    while (*link != NULL) {
+        ASTNode* node = *link;
+        // Dizi boyutu negatifse tanim hata verir
+        int bad_size = IS_ARRAY_TYPE(node->data_type) && node->left != NULL &&
+                       !(node->left->type == NODE_NUM_INT && node->left->int_val >= 0);
+        if (node->type == NODE_DECL && !references_var(body, node->id) && !has_call(node->left) &&
+            !may_trap(node->left) && !bad_size) {
+            *link = node->next;
+            discard(node);
+            removed_stmts++;
+            continue;
+        }
+        if (node->type == NODE_BLOCK) remove_unused_decls(&node->left, body);
+        else if (node->right != NULL && node->right->type == NODE_BLOCK) {
+            remove_unused_decls(&node->right->left, body);
+            if (node->else_body) remove_unused_decls(&node->else_body->left, body);
+        }
+        link = &node->next;
+    }
+}
+
+static void eliminate_dead_stores(ASTNode* func) {
+    live_name_count = 0;
+    if (!collect_names(func->left) || !collect_names(func->right)) return;
+    VarSet out;
+    memset(&out, 0, sizeof(out));
+    live_stmt(func->right, out, 1, NULL);
+    remove_unused_decls(&func->right->left, func->right);
+}
+
+// main'den cagri grafi uzerinden ulasilamayan fonksiyonlari sil
+static void mark_reachable(ASTNode* program, ASTNode* node, char* reached) {
+    if (node == NULL) return;
+    if (node->type == NODE_FUNC_CALL) {
+        int i = 0;
+        for (ASTNode* f = program->left; f != NULL; f = f->next, i++) {
+            if (f->type == NODE_FUNC_DECL && strcmp(f->id, node->id) == 0 && !reached[i]) {
+                reached[i] = 1;
+                mark_reachable(program, f->right, reached);
+            }
+        }
+    }
+    mark_reachable(program, node->left, reached);
+    mark_reachable(program, node->right, reached);
+    mark_reachable(program, node->else_body, reached);
+    mark_reachable(program, node->next, reached);
+}
+
+static int remove_dead_functions(ASTNode* program) {
+    int n = 0;
+    for (ASTNode* f = program->left; f != NULL; f = f->next) n++;
+    char* reached = (char*)calloc(n > 0 ? n : 1, 1);
+    ASTNode* main_decl = find_func_decl(program, "main");
+    if (main_decl == NULL) { free(reached); return 0; }
+
+    int i = 0;
+    for (ASTNode* f = program->left; f != NULL; f = f->next, i++) {
+        if (f == main_decl) reached[i] = 1;
+    }
+    mark_reachable(program, main_decl->right, reached);
+
+    int removed = 0;
+    ASTNode** link = &program->left;
+    i = 0;
+    while (*link != NULL) {
+        ASTNode* f = *link;
+        if (!reached[i++]) {
+            *link = f->next;
+            discard(f);
+            removed++;
+        } else {
+            link = &f->next;
+        }
+    }
+    free(reached);
+    return removed;
+}
+
+void eliminate_dead_code(ASTNode* program) {
+    removed_stmts = 0;
+    for (ASTNode* f = program->left; f != NULL; f = f->next) {
+        if (f->type != NODE_FUNC_DECL) continue;
+        if (f->right) remove_unreachable(f->right->left);
+        eliminate_dead_stores(f);
+    }
+    int funcs = remove_dead_functions(program);
+    if (funcs > 0 || removed_stmts > 0) {
+        printf("%d kullanilmayan fonksiyon ve %d olu ifade silindi.\n", funcs, removed_stmts);
+    }
+}
+
+void optimize_program(ASTNode* program) {
+    for (ASTNode* f = program->left; f != NULL; f = f->next) {
+        if (f->type == NODE_FUNC_DECL) f->right = fold_constants(f->right);
+    }
+    int n = specialize_functions(program);
+    if (n > 0) printf("%d cagri %d ozel fonksiyona yonlendirildi.\n", n, spec_count);
+    eliminate_dead_code(program);
+}
@@ -0,0 +1,13 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+#include "ast.h"
+
+// AST uzerinde calisan, semantik analizden sonra ve kod uretiminden once
+// uygulanan program capinda optimizasyonlar.
+
+ASTNode* fold_constants(ASTNode* stmt);
+int specialize_functions(ASTNode* program);
+void eliminate_dead_code(ASTNode* program);
+void optimize_program(ASTNode* program);
+
+#endif
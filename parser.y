@@ -1,8 +1,11 @@
 %{
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "ast.h"
 #include "compiler.h"
+#include "optimizer.h"
+#include "cache.h"
 
 extern int yylex();
 extern int yylineno;
@@ -22,11 +25,13 @@ ASTNode* root;
 %token <intVal> TOKEN_NUM_INT
 %token <floatVal> TOKEN_NUM_FLOAT
 %token TOKEN_BEGIN TOKEN_END TOKEN_IF TOKEN_UNLESS TOKEN_ELSE TOKEN_WHILE 
-%token TOKEN_READ TOKEN_PRINT TOKEN_RETURN
+%token TOKEN_READ TOKEN_PRINT TOKEN_RETURN TOKEN_MEMO
+%token TOKEN_FOR TOKEN_TO TOKEN_STEP
+%token TOKEN_SPAWN TOKEN_JOIN
 %token TOKEN_ASSIGN TOKEN_DOT TOKEN_KEY_INT TOKEN_KEY_FLOAT TOKEN_EQ TOKEN_NEQ
 
 %type <node> program func_list func_decl params param_list statements statement 
-%type <node> declaration assignment if_stmt unless_stmt while_stmt read_stmt print_stmt return_stmt block expr args
+%type <node> declaration assignment if_stmt unless_stmt while_stmt for_stmt spawn_stmt join_stmt read_stmt print_stmt return_stmt block expr args
 
 %left TOKEN_EQ TOKEN_NEQ
 %left '>' '<'
@@ -53,6 +58,7 @@ func_decl:
     | TOKEN_KEY_FLOAT TOKEN_ID '(' params ')' block { 
         $$ = create_func_decl($2, TYPE_FLOAT, $4, $6, yylineno);
     }
+    | TOKEN_MEMO func_decl { $2->memo = 1; $$ = $2; }
     ;
 
 params:
@@ -63,6 +69,8 @@ params:
 param_list:
     TOKEN_KEY_INT TOKEN_ID { $$ = create_param($2, TYPE_INT, yylineno); }
     | TOKEN_KEY_FLOAT TOKEN_ID { $$ = create_param($2, TYPE_FLOAT, yylineno); }
+    | TOKEN_KEY_INT '[' ']' TOKEN_ID { $$ = create_param($4, TYPE_INT_ARRAY, yylineno); }
+    | TOKEN_KEY_FLOAT '[' ']' TOKEN_ID { $$ = create_param($4, TYPE_FLOAT_ARRAY, yylineno); }
     | param_list ',' TOKEN_KEY_INT TOKEN_ID { 
         ASTNode* n = create_param($4, TYPE_INT, yylineno);
         ASTNode* temp = $1;
@@ -77,6 +85,20 @@ param_list:
         temp->next = n;
         $$ = $1;
     }
+    | param_list ',' TOKEN_KEY_INT '[' ']' TOKEN_ID {
+        ASTNode* n = create_param($6, TYPE_INT_ARRAY, yylineno);
+        ASTNode* temp = $1;
+        while(temp->next != NULL) temp = temp->next;
+        temp->next = n;
+        $$ = $1;
+    }
+    | param_list ',' TOKEN_KEY_FLOAT '[' ']' TOKEN_ID {
+        ASTNode* n = create_param($6, TYPE_FLOAT_ARRAY, yylineno);
+        ASTNode* temp = $1;
+        while(temp->next != NULL) temp = temp->next;
+        temp->next = n;
+        $$ = $1;
+    }
     ;
 
 block:
@@ -89,7 +111,8 @@ statements:
     ;
 
 statement:
-    declaration | assignment | if_stmt | unless_stmt | while_stmt 
+    declaration | assignment | if_stmt | unless_stmt | while_stmt | for_stmt
+    | spawn_stmt | join_stmt
     | read_stmt | print_stmt | return_stmt | block
     | expr TOKEN_DOT { $$ = $1; } 
     ;
@@ -97,10 +120,15 @@ statement:
 declaration:
     TOKEN_KEY_INT TOKEN_ID TOKEN_DOT { $$ = create_decl($2, TYPE_INT, yylineno); }
     | TOKEN_KEY_FLOAT TOKEN_ID TOKEN_DOT { $$ = create_decl($2, TYPE_FLOAT, yylineno); }
+    | TOKEN_KEY_INT '[' expr ']' TOKEN_ID TOKEN_DOT { $$ = create_array_decl($5, TYPE_INT, $3, yylineno); }
+    | TOKEN_KEY_FLOAT '[' expr ']' TOKEN_ID TOKEN_DOT { $$ = create_array_decl($5, TYPE_FLOAT, $3, yylineno); }
+    | TOKEN_KEY_INT '[' ']' TOKEN_ID TOKEN_DOT { $$ = create_array_decl($4, TYPE_INT, NULL, yylineno); }
+    | TOKEN_KEY_FLOAT '[' ']' TOKEN_ID TOKEN_DOT { $$ = create_array_decl($4, TYPE_FLOAT, NULL, yylineno); }
     ;
 
 assignment:
     TOKEN_ID TOKEN_ASSIGN expr TOKEN_DOT { $$ = create_assign($1, $3, yylineno); }
+    | TOKEN_ID '[' expr ']' TOKEN_ASSIGN expr TOKEN_DOT { $$ = create_index_assign($1, $3, $6, yylineno); }
     ;
 
 if_stmt:
@@ -116,6 +144,36 @@ while_stmt:
     TOKEN_WHILE '(' expr ')' block { $$ = create_while($3, $5, yylineno); }
     ;
 
+for_stmt:
+    TOKEN_FOR TOKEN_ID TOKEN_ASSIGN expr TOKEN_TO expr block {
+        $$ = create_for($2, $4, $6, NULL, $7, yylineno);
+    }
+    | TOKEN_FOR TOKEN_ID TOKEN_ASSIGN expr TOKEN_TO expr TOKEN_STEP expr block {
+        $$ = create_for($2, $4, $6, $8, $9, yylineno);
+    }
+    | TOKEN_FOR TOKEN_ID TOKEN_ASSIGN expr TOKEN_TO expr TOKEN_STEP '-' expr block {
+        // Dilde tekli eksi yok; 'step -1' icin 0 - ifade. Sabit adim hemen
+        // eksiye cevrilir ki 'step - 0' analizde reddedilsin
+        ASTNode* step = $9;
+        if (step->type == NODE_NUM_INT) step->int_val = -step->int_val;
+        else step = create_binop("-", create_int(0, yylineno), step, yylineno);
+        $$ = create_for($2, $4, $6, step, $10, yylineno);
+    }
+    ;
+
+spawn_stmt:
+    TOKEN_ID TOKEN_ASSIGN TOKEN_SPAWN TOKEN_ID '(' args ')' TOKEN_DOT {
+        $$ = create_spawn($1, create_func_call($4, $6, yylineno), yylineno);
+    }
+    | TOKEN_SPAWN TOKEN_ID '(' args ')' TOKEN_DOT {
+        $$ = create_spawn(NULL, create_func_call($2, $4, yylineno), yylineno);
+    }
+    ;
+
+join_stmt:
+    TOKEN_JOIN TOKEN_DOT { $$ = create_join(yylineno); }
+    ;
+
 read_stmt:
     TOKEN_READ '(' TOKEN_ID ')' TOKEN_DOT { $$ = create_read($3, yylineno); }
     ;
@@ -133,6 +191,7 @@ expr:
     | TOKEN_NUM_FLOAT { $$ = create_float($1, yylineno); }
     | TOKEN_ID { $$ = create_var($1, yylineno); }
     | TOKEN_ID '(' args ')' { $$ = create_func_call($1, $3, yylineno); }
+    | TOKEN_ID '[' expr ']' { $$ = create_index($1, $3, yylineno); }
     | expr '+' expr { $$ = create_binop("+", $1, $3, yylineno); }
     | expr '-' expr { $$ = create_binop("-", $1, $3, yylineno); }
     | expr '*' expr { $$ = create_binop("*", $1, $3, yylineno); }
@@ -163,12 +222,23 @@ int main(int argc, char** argv) {
         if (!file) { fprintf(stderr, "Dosya acilamadi: %s\n", argv[1]); return 1; }
         yyin = file;
     }
+    for (int i = 2; i < argc; i++) {
+        // --cache <dizin>: fonksiyon bytecode onbellegi (artimli derleme)
+        if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) cache_open(argv[++i]);
+        // --no-opt: optimizasyonsuz derleme (testlerde ciktilar karsilastirilir)
+        else if (strcmp(argv[i], "--no-opt") == 0) optimize_enabled = 0;
+    }
 
     if (yyparse() == 0) {
         printf("\n--- SEMANTIK ANALIZ ---\n");
         if (semantic_analysis(root) == 0) {
             printf("Semantik Analiz Basarili!\n");
 
+            if (optimize_enabled) {
+                printf("\n--- OPTIMIZASYON ---\n");
+                optimize_program(root);
+            }
+
             printf("\n--- ABSTRACT SYNTAX TREE ---\n");
             print_ast_tree(root, 0);
             
@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include "vm.h"
+
+// --- VM SUNUCUSU ---
+// vm --serve <soket>: yuklenen programlari bellekte tutar, Unix soketinden
+// gelen calistirma isteklerini isci havuzunda yurutur. Her baglanti tek
+// bir istektir (sayilar uint32, makinenin bayt sirasiyla):
+//   istemci -> program_boyu, girdi_boyu, program metni, girdi
+//   sunucu  -> durum (VmStatus), cikti_boyu, hata_boyu, cikti, hata
+// Programlar metinlerinin ozetiyle (FNV-1a) anahtarlanir; ayni bytecode
+// ikinci istekte yeniden ayristirilmaz.
+
+#define MAX_PROGRAMS 64
+#define MAX_REQUEST (16 * 1024 * 1024)
+#define IO_TIMEOUT_SEC 5 // Yarim kalan istemciler isciyi en fazla bu kadar tutar
+
+typedef struct {
+    unsigned long long hash;
+    size_t len;
+    Program* prog;
+    int refs;           // Bu programi calistiran istek sayisi
+    unsigned long used; // Son kullanim sirasi (LRU)
+} CachedProgram;
+
+static CachedProgram programs[MAX_PROGRAMS];
+static int program_count = 0;
+static unsigned long use_clock = 0;
+static pthread_mutex_t programs_lock = PTHREAD_MUTEX_INITIALIZER;
+static VmLimits request_limits; // Her istege uygulanir (--max-* secenekleri)
+
+static unsigned long long hash_text(const char* text, size_t len) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; i++) h = (h ^ (unsigned char)text[i]) * 1099511628211ULL;
+    return h;
+}
+
+static CachedProgram* find_program(unsigned long long hash, size_t len) {
+    for (int i = 0; i < program_count; i++) {
+        if (programs[i].prog != NULL && programs[i].hash == hash && programs[i].len == len) return &programs[i];
+    }
+    return NULL;
+}
+
+// Bos yer yoksa kullanilmayan en eski program cikarilir; hepsi
+// kullanimdaysa NULL
+static CachedProgram* free_slot() {
+    if (program_count < MAX_PROGRAMS) return &programs[program_count++];
+    CachedProgram* victim = NULL;
+    for (int i = 0; i < program_count; i++) {
+        if (programs[i].refs == 0 && (victim == NULL || programs[i].used < victim->used)) victim = &programs[i];
+    }
+    if (victim != NULL) {
+        free_program(victim->prog);
+        victim->prog = NULL;
+    }
+    return victim;
+}
+
+// Programi onbellekten alir ya da yukleyip ekler; release_program ile birakilir
+static Program* acquire_program(const char* text, size_t len, char* err) {
+    unsigned long long hash = hash_text(text, len);
+    pthread_mutex_lock(&programs_lock);
+    CachedProgram* c = find_program(hash, len);
+    if (c != NULL) {
+        c->refs++;
+        c->used = ++use_clock;
+        pthread_mutex_unlock(&programs_lock);
+        return c->prog;
+    }
+    pthread_mutex_unlock(&programs_lock);
+
+    // Ayristirma kilit disinda yapilir
+    if (len == 0) { strcpy(err, "Hata: Bos program"); return NULL; }
+    FILE* f = fmemopen((void*)text, len, "r");
+    if (!f) { strcpy(err, "Bellek yetersiz!"); return NULL; }
+    Program* prog = load_program(f, err);
+    fclose(f);
+    if (!prog) return NULL;
+
+    pthread_mutex_lock(&programs_lock);
+    if ((c = find_program(hash, len)) != NULL) { // Bu arada baska bir istek yukledi
+        free_program(prog);
+        prog = c->prog;
+    } else if ((c = free_slot()) != NULL) {
+        c->hash = hash;
+        c->len = len;
+        c->prog = prog;
+        c->refs = 0;
+    }
+    if (c != NULL) {
+        c->refs++;
+        c->used = ++use_clock;
+    }
+    pthread_mutex_unlock(&programs_lock);
+    return prog; // c == NULL ise onbellege girmedi, release_program siler
+}
+
+static void release_program(Program* prog) {
+    pthread_mutex_lock(&programs_lock);
+    int cached = 0;
+    for (int i = 0; i < program_count; i++) {
+        if (programs[i].prog == prog) { programs[i].refs--; cached = 1; break; }
+    }
+    pthread_mutex_unlock(&programs_lock);
+    if (!cached) free_program(prog);
+}
+
+static int read_full(int fd, void* buf, size_t len) {
+    char* p = (char*)buf;
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return 0;
+        p += n;
+        len -= n;
+    }
+    return 1;
+}
+
+static int write_full(int fd, const void* buf, size_t len) {
+    const char* p = (const char*)buf;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return 0;
+        p += n;
+        len -= n;
+    }
+    return 1;
+}
+
+// input girdi_boyu + 1 baytliktir: fmemopen bos tampon kabul etmedigi icin
+// sona bir satir sonu eklenir
+static void run_request(Worker* w, int fd, const char* text, size_t len, char* input, size_t input_len) {
+    VmError err = {VM_ERR_RUNTIME, ""};
+    VmStatus status = VM_ERR_RUNTIME;
+    char* out_buf = NULL;
+    size_t out_len = 0;
+    Program* prog = acquire_program(text, len, err.message);
+    if (prog != NULL) {
+        input[input_len] = '\n';
+        FILE* in = fmemopen(input, input_len + 1, "r");
+        FILE* out = open_memstream(&out_buf, &out_len);
+        Exec* ex = in && out ? exec_create(prog, in, out, &request_limits) : NULL;
+        if (ex != NULL) {
+            if ((status = exec_run(ex, w, &err)) == VM_OK) err.message[0] = '\0';
+            exec_free(ex);
+        } else {
+            strcpy(err.message, "Bellek yetersiz!");
+        }
+        if (in) fclose(in);
+        if (out) fclose(out);
+        release_program(prog);
+    }
+    uint32_t head[3] = {status, (uint32_t)out_len, (uint32_t)strlen(err.message)};
+    if (write_full(fd, head, sizeof(head)) && write_full(fd, out_buf, out_len)) write_full(fd, err.message, head[2]);
+    free(out_buf);
+}
+
+// Havuzdaki bir iscide calisir: istegi okur, yurutur, yaniti yazar
+static void handle_request(Worker* w, void* arg) {
+    int fd = (int)(intptr_t)arg;
+    uint32_t head[2];
+    if (read_full(fd, head, sizeof(head)) && head[0] <= MAX_REQUEST && head[1] <= MAX_REQUEST) {
+        char* text = (char*)malloc(head[0] + 1);
+        char* input = (char*)malloc(head[1] + 1);
+        if (text && input && read_full(fd, text, head[0]) && read_full(fd, input, head[1])) {
+            run_request(w, fd, text, head[0], input, head[1]);
+        }
+        free(text);
+        free(input);
+    }
+    close(fd);
+}
+
+int serve_main(const char* path, const VmLimits* limits) {
+    struct sockaddr_un addr;
+    if (strlen(path) >= sizeof(addr.sun_path)) { fprintf(stderr, "Hata: Soket yolu cok uzun %s\n", path); return 1; }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+
+    struct stat st;
+    if (stat(path, &st) == 0 && S_ISSOCK(st.st_mode)) unlink(path); // Onceki calismadan kalan soket
+    int srv = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (srv < 0 || bind(srv, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(srv, 128) != 0) {
+        fprintf(stderr, "Hata: Soket acilamadi %s (%s)\n", path, strerror(errno));
+        return 1;
+    }
+    request_limits = *limits;
+    signal(SIGPIPE, SIG_IGN); // Erken kapanan istemci yazma hatasi olarak gorulur
+    start_pool(1);            // Bu is parcacigi yalnizca baglanti kabul eder
+    fprintf(stderr, "Sunucu: %s dinleniyor\n", path);
+
+    for (;;) {
+        int fd = accept(srv, NULL, NULL);
+        if (fd < 0) continue;
+        struct timeval tv = {IO_TIMEOUT_SEC, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        if (!submit_job(handle_request, (void*)(intptr_t)fd)) close(fd); // Kuyruk dolu
+    }
+    return 0;
+}
+
+// --- ISTEMCI ---
+// vm --client <soket> <bytecode_file>: girdi stdin'den (terminal degilse)
+// okunur; cikti, hata mesaji ve cikis kodu dogrudan calistirmadaki gibidir
+
+static char* read_all(FILE* f, size_t* len) {
+    size_t cap = 4096;
+    char* buf = (char*)malloc(cap);
+    *len = 0;
+    while (buf != NULL) {
+        *len += fread(buf + *len, 1, cap - *len, f);
+        if (*len < cap) break;
+        char* grown = (char*)realloc(buf, cap *= 2);
+        if (grown == NULL) free(buf);
+        buf = grown;
+    }
+    return buf;
+}
+
+int client_main(const char* path, const char* program_file) {
+    FILE* f = fopen(program_file, "rb");
+    if (!f) { printf("Dosya acilamadi: %s\n", program_file); return 1; }
+    size_t len, input_len = 0;
+    char* text = read_all(f, &len);
+    fclose(f);
+    char* input = isatty(STDIN_FILENO) ? (char*)calloc(1, 1) : read_all(stdin, &input_len);
+    if (!text || !input) { printf("Bellek yetersiz!\n"); return 1; }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        printf("Hata: Sunucuya baglanilamadi %s\n", path);
+        return 1;
+    }
+
+    uint32_t req[2] = {(uint32_t)len, (uint32_t)input_len};
+    uint32_t resp[3];
+    if (!write_full(fd, req, sizeof(req)) || !write_full(fd, text, len) || !write_full(fd, input, input_len) ||
+        !read_full(fd, resp, sizeof(resp))) {
+        printf("Hata: Sunucu yanit vermedi\n");
+        return 1;
+    }
+    char* out = (char*)malloc(resp[1] + 1);
+    char* err = (char*)malloc(resp[2] + 1);
+    if (!out || !err || !read_full(fd, out, resp[1]) || !read_full(fd, err, resp[2])) {
+        printf("Hata: Sunucu yanit vermedi\n");
+        return 1;
+    }
+    fwrite(out, 1, resp[1], stdout);
+    if (resp[0] != 0) printf("%.*s\n", (int)resp[2], err);
+    close(fd);
+    return (int)resp[0];
+}
@@ -0,0 +1,455 @@
+#include <stdlib.h>
+#include <string.h>
+#include "simd.h"
+
+// Skaler yolda derleyici a*b+c'yi FMA'ya cevirmesin: yuvarlama SIMD
+// yollariyla ayni kalmali.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#define LANES 8 // Indirgemelerde kulvar sayisi (AVX2 genisligi)
+
+enum { ISA_SCALAR, ISA_SSE2, ISA_AVX2 };
+static int isa = -1;
+
+static int detect_isa() {
+    if (isa >= 0) return isa;
+    isa = ISA_SCALAR;
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    isa = __builtin_cpu_supports("avx2") ? ISA_AVX2 : ISA_SSE2;
+#endif
+    const char* limit = getenv("VM_SIMD");
+    if (limit != NULL) {
+        if (strcmp(limit, "scalar") == 0) isa = ISA_SCALAR;
+        else if (strcmp(limit, "sse2") == 0 && isa > ISA_SSE2) isa = ISA_SSE2;
+    }
+    return isa;
+}
+
+const char* vec_isa_name() {
+    static const char* names[] = {"scalar", "sse2", "avx2"};
+    return names[detect_isa()];
+}
+
+// --- SKALER YOL ---
+// SIMD yollarinin bitirmedigi kuyruk elemanlari da buradan gecer.
+
+static void binop_i32_scalar(VecOp op, int* dst, const int* a, int sa, const int* b, int sb, int i, int n) {
+    for (; i < n; i++) {
+        unsigned int x = (unsigned int)(a ? a[i] : sa);
+        unsigned int y = (unsigned int)(b ? b[i] : sb);
+        switch (op) {
+            case VEC_ADD: dst[i] = (int)(x + y); break;
+            case VEC_SUB: dst[i] = (int)(x - y); break;
+            case VEC_MUL: dst[i] = (int)(x * y); break;
+            case VEC_DIV: dst[i] = y == 0xffffffffu ? (int)(0u - x) : (int)x / (int)y; break; // INT_MIN / -1 sarar
+        }
+    }
+}
+
+static void binop_f32_scalar(VecOp op, float* dst, const float* a, float sa, const float* b, float sb, int i, int n) {
+    for (; i < n; i++) {
+        float x = a ? a[i] : sa;
+        float y = b ? b[i] : sb;
+        switch (op) {
+            case VEC_ADD: dst[i] = x + y; break;
+            case VEC_SUB: dst[i] = x - y; break;
+            case VEC_MUL: dst[i] = x * y; break;
+            case VEC_DIV: dst[i] = x / y; break;
+        }
+    }
+}
+
+// Kulvar toplamlarini sabit sirayla birlestir
+static float combine_sum_f32(const float* acc) {
+    float r = acc[0];
+    for (int k = 1; k < LANES; k++) r += acc[k];
+    return r;
+}
+
+static float min_f32(float acc, float x) { return acc < x ? acc : x; } // _mm_min_ps ile ayni
+static float max_f32(float acc, float x) { return acc > x ? acc : x; } // _mm_max_ps ile ayni
+
+#ifdef SIMD_X86
+
+// --- SSE2 ---
+
+static __m128i mullo_sse2(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static __m128i min_epi32_sse2(__m128i a, __m128i b) {
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+}
+
+static __m128i max_epi32_sse2(__m128i a, __m128i b) {
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+
+#define SSE_BINOP_I(VOP) \
+    for (; i + 4 <= n; i += 4) { \
+        __m128i x = a ? _mm_loadu_si128((const __m128i*)(a + i)) : va; \
+        __m128i y = b ? _mm_loadu_si128((const __m128i*)(b + i)) : vb; \
+        _mm_storeu_si128((__m128i*)(dst + i), VOP(x, y)); \
+    }
+
+#define SSE_BINOP_F(VOP) \
+    for (; i + 4 <= n; i += 4) { \
+        __m128 x = a ? _mm_loadu_ps(a + i) : va; \
+        __m128 y = b ? _mm_loadu_ps(b + i) : vb; \
+        _mm_storeu_ps(dst + i, VOP(x, y)); \
+    }
+
+// Islenen eleman sayisini doner; kalan skaler yoldan gecer
+static int binop_i32_sse2(VecOp op, int* dst, const int* a, int sa, const int* b, int sb, int n) {
+    __m128i va = _mm_set1_epi32(sa), vb = _mm_set1_epi32(sb);
+    int i = 0;
+    switch (op) {
+        case VEC_ADD: SSE_BINOP_I(_mm_add_epi32); break;
+        case VEC_SUB: SSE_BINOP_I(_mm_sub_epi32); break;
+        case VEC_MUL: SSE_BINOP_I(mullo_sse2); break;
+        case VEC_DIV: break; // Tamsayi bolmenin vektor karsiligi yok
+    }
+    return i;
+}
+
+static int binop_f32_sse2(VecOp op, float* dst, const float* a, float sa, const float* b, float sb, int n) {
+    __m128 va = _mm_set1_ps(sa), vb = _mm_set1_ps(sb);
+    int i = 0;
+    switch (op) {
+        case VEC_ADD: SSE_BINOP_F(_mm_add_ps); break;
+        case VEC_SUB: SSE_BINOP_F(_mm_sub_ps); break;
+        case VEC_MUL: SSE_BINOP_F(_mm_mul_ps); break;
+        case VEC_DIV: SSE_BINOP_F(_mm_div_ps); break;
+    }
+    return i;
+}
+
+// 8 kulvar = iki SSE yazmaci (0-3 ve 4-7)
+static void sum_f32_sse2(const float* a, int n8, float* acc) {
+    __m128 lo = _mm_setzero_ps(), hi = _mm_setzero_ps();
+    for (int i = 0; i < n8; i += LANES) {
+        lo = _mm_add_ps(lo, _mm_loadu_ps(a + i));
+        hi = _mm_add_ps(hi, _mm_loadu_ps(a + i + 4));
+    }
+    _mm_storeu_ps(acc, lo);
+    _mm_storeu_ps(acc + 4, hi);
+}
+
+static void dot_f32_sse2(const float* a, const float* b, int n8, float* acc) {
+    __m128 lo = _mm_setzero_ps(), hi = _mm_setzero_ps();
+    for (int i = 0; i < n8; i += LANES) {
+        lo = _mm_add_ps(lo, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        hi = _mm_add_ps(hi, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    _mm_storeu_ps(acc, lo);
+    _mm_storeu_ps(acc + 4, hi);
+}
+
+static void minmax_f32_sse2(const float* a, int n8, float* acc, int is_max) {
+    __m128 lo = _mm_loadu_ps(a), hi = _mm_loadu_ps(a + 4);
+    for (int i = LANES; i < n8; i += LANES) {
+        __m128 x = _mm_loadu_ps(a + i), y = _mm_loadu_ps(a + i + 4);
+        lo = is_max ? _mm_max_ps(lo, x) : _mm_min_ps(lo, x);
+        hi = is_max ? _mm_max_ps(hi, y) : _mm_min_ps(hi, y);
+    }
+    _mm_storeu_ps(acc, lo);
+    _mm_storeu_ps(acc + 4, hi);
+}
+
+static int sum_i32_sse2(const int* a, int n, int* pi) {
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) acc = _mm_add_epi32(acc, _mm_loadu_si128((const __m128i*)(a + i)));
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    *pi = i;
+    return (int)((unsigned int)lanes[0] + (unsigned int)lanes[1] + (unsigned int)lanes[2] + (unsigned int)lanes[3]);
+}
+
+static int dot_i32_sse2(const int* a, const int* b, int n, int* pi) {
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i p = mullo_sse2(_mm_loadu_si128((const __m128i*)(a + i)), _mm_loadu_si128((const __m128i*)(b + i)));
+        acc = _mm_add_epi32(acc, p);
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    *pi = i;
+    return (int)((unsigned int)lanes[0] + (unsigned int)lanes[1] + (unsigned int)lanes[2] + (unsigned int)lanes[3]);
+}
+
+static int minmax_i32_sse2(const int* a, int n, int is_max, int* pi) {
+    __m128i acc = _mm_loadu_si128((const __m128i*)a);
+    int i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        acc = is_max ? max_epi32_sse2(acc, x) : min_epi32_sse2(acc, x);
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    int r = lanes[0];
+    for (int k = 1; k < 4; k++) r = is_max ? (lanes[k] > r ? lanes[k] : r) : (lanes[k] < r ? lanes[k] : r);
+    *pi = i;
+    return r;
+}
+
+// --- AVX2 ---
+
+#define AVX2 __attribute__((target("avx2")))
+
+#define AVX_BINOP_I(VOP) \
+    for (; i + 8 <= n; i += 8) { \
+        __m256i x = a ? _mm256_loadu_si256((const __m256i*)(a + i)) : va; \
+        __m256i y = b ? _mm256_loadu_si256((const __m256i*)(b + i)) : vb; \
+        _mm256_storeu_si256((__m256i*)(dst + i), VOP(x, y)); \
+    }
+
+#define AVX_BINOP_F(VOP) \
+    for (; i + 8 <= n; i += 8) { \
+        __m256 x = a ? _mm256_loadu_ps(a + i) : va; \
+        __m256 y = b ? _mm256_loadu_ps(b + i) : vb; \
+        _mm256_storeu_ps(dst + i, VOP(x, y)); \
+    }
+
+AVX2 static int binop_i32_avx2(VecOp op, int* dst, const int* a, int sa, const int* b, int sb, int n) {
+    __m256i va = _mm256_set1_epi32(sa), vb = _mm256_set1_epi32(sb);
+    int i = 0;
+    switch (op) {
+        case VEC_ADD: AVX_BINOP_I(_mm256_add_epi32); break;
+        case VEC_SUB: AVX_BINOP_I(_mm256_sub_epi32); break;
+        case VEC_MUL: AVX_BINOP_I(_mm256_mullo_epi32); break;
+        case VEC_DIV: break;
+    }
+    return i;
+}
+
+AVX2 static int binop_f32_avx2(VecOp op, float* dst, const float* a, float sa, const float* b, float sb, int n) {
+    __m256 va = _mm256_set1_ps(sa), vb = _mm256_set1_ps(sb);
+    int i = 0;
+    switch (op) {
+        case VEC_ADD: AVX_BINOP_F(_mm256_add_ps); break;
+        case VEC_SUB: AVX_BINOP_F(_mm256_sub_ps); break;
+        case VEC_MUL: AVX_BINOP_F(_mm256_mul_ps); break;
+        case VEC_DIV: AVX_BINOP_F(_mm256_div_ps); break;
+    }
+    return i;
+}
+
+AVX2 static void sum_f32_avx2(const float* a, int n8, float* acc) {
+    __m256 s = _mm256_setzero_ps();
+    for (int i = 0; i < n8; i += LANES) s = _mm256_add_ps(s, _mm256_loadu_ps(a + i));
+    _mm256_storeu_ps(acc, s);
+}
+
+AVX2 static void dot_f32_avx2(const float* a, const float* b, int n8, float* acc) {
+    __m256 s = _mm256_setzero_ps();
+    for (int i = 0; i < n8; i += LANES) {
+        s = _mm256_add_ps(s, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    _mm256_storeu_ps(acc, s);
+}
+
+AVX2 static void minmax_f32_avx2(const float* a, int n8, float* acc, int is_max) {
+    __m256 s = _mm256_loadu_ps(a);
+    for (int i = LANES; i < n8; i += LANES) {
+        __m256 x = _mm256_loadu_ps(a + i);
+        s = is_max ? _mm256_max_ps(s, x) : _mm256_min_ps(s, x);
+    }
+    _mm256_storeu_ps(acc, s);
+}
+
+AVX2 static int sum_i32_avx2(const int* a, int n, int* pi) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) acc = _mm256_add_epi32(acc, _mm256_loadu_si256((const __m256i*)(a + i)));
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    unsigned int r = 0;
+    for (int k = 0; k < 8; k++) r += (unsigned int)lanes[k];
+    *pi = i;
+    return (int)r;
+}
+
+AVX2 static int dot_i32_avx2(const int* a, const int* b, int n, int* pi) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i p = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                       _mm256_loadu_si256((const __m256i*)(b + i)));
+        acc = _mm256_add_epi32(acc, p);
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    unsigned int r = 0;
+    for (int k = 0; k < 8; k++) r += (unsigned int)lanes[k];
+    *pi = i;
+    return (int)r;
+}
+
+AVX2 static int minmax_i32_avx2(const int* a, int n, int is_max, int* pi) {
+    __m256i acc = _mm256_loadu_si256((const __m256i*)a);
+    int i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        acc = is_max ? _mm256_max_epi32(acc, x) : _mm256_min_epi32(acc, x);
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    int r = lanes[0];
+    for (int k = 1; k < 8; k++) r = is_max ? (lanes[k] > r ? lanes[k] : r) : (lanes[k] < r ? lanes[k] : r);
+    *pi = i;
+    return r;
+}
+
+#endif // SIMD_X86
+
+// --- DISA ACIK FONKSIYONLAR ---
+
+int vec_binop_i32(VecOp op, int* dst, const int* a, int sa, const int* b, int sb, int n) {
+    if (op == VEC_DIV) {
+        if (b == NULL && sb == 0) return -1;
+        for (int i = 0; b != NULL && i < n; i++) {
+            if (b[i] == 0) return -1;
+        }
+    }
+    int i = 0;
+#ifdef SIMD_X86
+    if (detect_isa() == ISA_AVX2) i = binop_i32_avx2(op, dst, a, sa, b, sb, n);
+    else if (isa == ISA_SSE2) i = binop_i32_sse2(op, dst, a, sa, b, sb, n);
+#endif
+    binop_i32_scalar(op, dst, a, sa, b, sb, i, n);
+    return 0;
+}
+
+void vec_binop_f32(VecOp op, float* dst, const float* a, float sa, const float* b, float sb, int n) {
+    int i = 0;
+#ifdef SIMD_X86
+    if (detect_isa() == ISA_AVX2) i = binop_f32_avx2(op, dst, a, sa, b, sb, n);
+    else if (isa == ISA_SSE2) i = binop_f32_sse2(op, dst, a, sa, b, sb, n);
+#endif
+    binop_f32_scalar(op, dst, a, sa, b, sb, i, n);
+}
+
+// Duz saklama dongusu; derleyici zaten vektorlestirir
+void vec_fill_i32(int* dst, int v, int n) {
+    for (int i = 0; i < n; i++) dst[i] = v;
+}
+
+void vec_fill_f32(float* dst, float v, int n) {
+    for (int i = 0; i < n; i++) dst[i] = v;
+}
+
+int vec_sum_i32(const int* a, int n) {
+    int i = 0;
+    unsigned int r = 0;
+#ifdef SIMD_X86
+    if (detect_isa() == ISA_AVX2) r = (unsigned int)sum_i32_avx2(a, n, &i);
+    else if (isa == ISA_SSE2) r = (unsigned int)sum_i32_sse2(a, n, &i);
+#endif
+    for (; i < n; i++) r += (unsigned int)a[i];
+    return (int)r;
+}
+
+int vec_dot_i32(const int* a, const int* b, int n) {
+    int i = 0;
+    unsigned int r = 0;
+#ifdef SIMD_X86
+    if (detect_isa() == ISA_AVX2) r = (unsigned int)dot_i32_avx2(a, b, n, &i);
+    else if (isa == ISA_SSE2) r = (unsigned int)dot_i32_sse2(a, b, n, &i);
+#endif
+    for (; i < n; i++) r += (unsigned int)a[i] * (unsigned int)b[i];
+    return (int)r;
+}
+
+static int minmax_i32(const int* a, int n, int is_max) {
+    int i = 1;
+    int r = a[0];
+#ifdef SIMD_X86
+    if (n >= 8 && detect_isa() == ISA_AVX2) r = minmax_i32_avx2(a, n, is_max, &i);
+    else if (n >= 4 && detect_isa() == ISA_SSE2) r = minmax_i32_sse2(a, n, is_max, &i);
+#endif
+    for (; i < n; i++) r = is_max ? (a[i] > r ? a[i] : r) : (a[i] < r ? a[i] : r);
+    return r;
+}
+
+int vec_min_i32(const int* a, int n) { return minmax_i32(a, n, 0); }
+int vec_max_i32(const int* a, int n) { return minmax_i32(a, n, 1); }
+
+// Float indirgemeleri: ilk n8 eleman i % 8 kulvarinda biriktirilir, kulvarlar
+// sirayla birlestirilir, kuyruk sirayla eklenir.
+
+float vec_sum_f32(const float* a, int n) {
+    int n8 = n - n % LANES;
+    float acc[LANES] = {0};
+#ifdef SIMD_X86
+    if (detect_isa() == ISA_AVX2) sum_f32_avx2(a, n8, acc);
+    else if (isa == ISA_SSE2) sum_f32_sse2(a, n8, acc);
+    else
+#endif
+    for (int i = 0; i < n8; i++) acc[i % LANES] += a[i];
+    float r = combine_sum_f32(acc);
+    for (int i = n8; i < n; i++) r += a[i];
+    return r;
+}
+
+float vec_dot_f32(const float* a, const float* b, int n) {
+    int n8 = n - n % LANES;
+    float acc[LANES] = {0};
+#ifdef SIMD_X86
+    if (detect_isa() == ISA_AVX2) dot_f32_avx2(a, b, n8, acc);
+    else if (isa == ISA_SSE2) dot_f32_sse2(a, b, n8, acc);
+    else
+#endif
+    for (int i = 0; i < n8; i++) {
+        float p = a[i] * b[i];
+        acc[i % LANES] += p;
+    }
+    float r = combine_sum_f32(acc);
+    for (int i = n8; i < n; i++) {
+        float p = a[i] * b[i];
+        r += p;
+    }
+    return r;
+}
+
+static float minmax_f32(const float* a, int n, int is_max) {
+    int n8 = n - n % LANES;
+    float r = a[0];
+    if (n8 > 0) {
+        float acc[LANES];
+#ifdef SIMD_X86
+        if (detect_isa() == ISA_AVX2) minmax_f32_avx2(a, n8, acc, is_max);
+        else if (isa == ISA_SSE2) minmax_f32_sse2(a, n8, acc, is_max);
+        else
+#endif
+        {
+            memcpy(acc, a, sizeof(acc));
+            for (int i = LANES; i < n8; i++) {
+                acc[i % LANES] = is_max ? max_f32(acc[i % LANES], a[i]) : min_f32(acc[i % LANES], a[i]);
+            }
+        }
+        r = acc[0];
+        for (int k = 1; k < LANES; k++) r = is_max ? max_f32(r, acc[k]) : min_f32(r, acc[k]);
+    }
+    for (int i = n8 > 0 ? n8 : 1; i < n; i++) r = is_max ? max_f32(r, a[i]) : min_f32(r, a[i]);
+    return r;
+}
+
+float vec_min_f32(const float* a, int n) { return minmax_f32(a, n, 0); }
+float vec_max_f32(const float* a, int n) { return minmax_f32(a, n, 1); }
@@ -0,0 +1,36 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+// --- DIZI CEKIRDEKLERI ---
+// VM'in toplu dizi islemleri icin vektorel donguler. x86'da calisma aninda
+// AVX2 varsa o, yoksa SSE2 kullanilir; diger mimarilerde skaler dongu
+// calisir. VM_SIMD=scalar|sse2|avx2 ortam degiskeni seviyeyi sinirlar.
+//
+// Tamsayi aritmetigi 32 bit sarmalidir (VM'deki skaler islemlerle ayni).
+// Float indirgemeleri (sum, min, max, dot) her yolda ayni 8 kulvarli
+// sirayla yapilir; boylece sonuc secilen komut setinden bagimsizdir.
+
+typedef enum { VEC_ADD, VEC_SUB, VEC_MUL, VEC_DIV } VecOp;
+
+// a ya da b NULL ise o islenen yerine skaler (sa / sb) kullanilir.
+// Tamsayi bolmede sifir bolen varsa hicbir sey yazilmaz ve -1 doner.
+int vec_binop_i32(VecOp op, int* dst, const int* a, int sa, const int* b, int sb, int n);
+void vec_binop_f32(VecOp op, float* dst, const float* a, float sa, const float* b, float sb, int n);
+
+void vec_fill_i32(int* dst, int v, int n);
+void vec_fill_f32(float* dst, float v, int n);
+
+int vec_sum_i32(const int* a, int n);
+float vec_sum_f32(const float* a, int n);
+int vec_dot_i32(const int* a, const int* b, int n);
+float vec_dot_f32(const float* a, const float* b, int n);
+
+// n > 0 olmali
+int vec_min_i32(const int* a, int n);
+int vec_max_i32(const int* a, int n);
+float vec_min_f32(const float* a, int n);
+float vec_max_f32(const float* a, int n);
+
+const char* vec_isa_name();
+
+#endif
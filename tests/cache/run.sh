@@ -0,0 +1,12 @@
+#!/bin/sh
+# Artimli derleme: ayni dizinle ardisik derlemelerde degismeyen fonksiyonlar
+# onbellekten gelir, duzenlenen (v2'de cube) yeniden derlenir. Her adimin
+# onbellek satiri ve VM ciktisi tests/cache/run.out ile karsilastirilir.
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+for step in v1 v1 v2 v1 "v1 --no-opt"; do
+    set -- $step
+    echo "== $*"
+    ./mycompiler tests/cache/$1.txt --cache "$dir" $2 | grep '^Onbellek:'
+    echo 3 | ./vm output.vm
+done 2>&1 | cmp -s - tests/cache/run.out
@@ -0,0 +1,23 @@
+#!/bin/sh
+# Calisma sinirlari: her sinir turu (adim, sure, derinlik, bellek) icin bir
+# calistirma ve sinirsiz sayilacak kadar genis sinirlarla bir kontrol
+# calistirmasi. Ciktilar ve cikis kodlari tests/limits/run.out ile
+# karsilastirilir.
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+for p in ok loop deep alloc; do
+    ./mycompiler tests/limits/$p.txt >/dev/null && cp output.vm "$dir/$p.vm" || exit 1
+done
+run() {
+    echo "== $*" | sed "s|$dir/||g"
+    "$@" 2>&1
+    echo "rc=$?"
+}
+exec 3>"$dir/out"
+echo 6 | run ./vm "$dir/ok.vm" --max-steps 100000 --max-time 5000 --max-depth 50 --max-memory 1048576 >&3
+run ./vm "$dir/loop.vm" --max-steps 100000 >&3
+run ./vm "$dir/loop.vm" --max-time 100 >&3
+run ./vm "$dir/deep.vm" --max-depth 50 >&3
+run ./vm "$dir/alloc.vm" --max-memory 10000 >&3
+exec 3>&-
+cmp -s "$dir/out" tests/limits/run.out
@@ -0,0 +1,29 @@
+#!/bin/sh
+# Kalici sunucu: --max-steps ile baslatilan sunucuya istemci istekleri.
+# Ayni program tekrar istenir, sinira takilan ve hatayla biten istekler
+# sunucuyu durdurmaz. Ciktilar ve cikis kodlari tests/serve/run.out ile
+# karsilastirilir.
+dir=$(mktemp -d) || exit 1
+pid=
+trap '[ -n "$pid" ] && kill $pid; rm -rf "$dir"' EXIT
+for p in ok loop; do
+    ./mycompiler tests/limits/$p.txt >/dev/null && cp output.vm "$dir/$p.vm" || exit 1
+done
+run() {
+    echo "== $*" | sed "s|$dir/||g"
+    "$@" 2>&1
+    echo "rc=$?"
+}
+exec 3>"$dir/out"
+./vm --serve "$dir/vm.sock" --max-steps 100000 >/dev/null 2>&1 3>&- &
+pid=$!
+for i in 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20; do
+    [ -S "$dir/vm.sock" ] && break
+    sleep 0.1
+done
+echo 6 | run ./vm --client "$dir/vm.sock" "$dir/ok.vm" >&3
+run ./vm --client "$dir/vm.sock" "$dir/loop.vm" </dev/null >&3
+echo 0 | run ./vm --client "$dir/vm.sock" "$dir/ok.vm" >&3
+echo 8 | run ./vm --client "$dir/vm.sock" "$dir/ok.vm" >&3
+exec 3>&-
+cmp -s "$dir/out" tests/serve/run.out
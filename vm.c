@@ -2,28 +2,69 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdarg.h>
+#include <setjmp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include "simd.h"
+#include "vm.h"
 
 #define MAX_STACK 1000
 #define MAX_MEMORY 1000
 #define MAX_CODE 1000
 #define MAX_LABELS 100
 #define MAX_CALL_STACK 100
+#define MAX_MEMO_FUNCS 32
+#define MAX_MEMO_ARGS 10
+#define MEMO_CACHE_SIZE 4096 // Fonksiyon basina sinirli onbellek (dogrudan eslemeli)
+#define FUEL_SLICE 256       // Sinir ve iptal denetimleri arasindaki adim sayisi
 
 typedef enum {
     TYPE_INT,
-    TYPE_FLOAT
+    TYPE_FLOAT,
+    TYPE_ARRAY
 } DataType;
 
+// Dizi: kutusuz (unboxed), hizali ve bitisik eleman deposu. Yiginda ve
+// parametrelerde referans olarak gezer; sahibi onu tanimlayan cercevedir.
+typedef struct {
+    DataType elem; // TYPE_INT ya da TYPE_FLOAT
+    int len, cap;
+    void* data;
+} Array;
+
 typedef struct {
     DataType type;
-    union { int i_val; float f_val; } val;
+    union { int i_val; float f_val; Array* arr; } val;
 } StackItem;
 
+// Komut adlari yuklemede bir kez cozulur; run tamsayi uzerinden dallanir
+#define OPCODES(X) \
+    X(PUSH_INT) X(PUSH_FLOAT) X(ADD) X(SUB) X(MUL) X(DIV) X(MOD) X(POW) \
+    X(GT) X(LT) X(EQ) X(NEQ) X(PRINT) X(READ) X(STORE) X(LOAD) X(DECLARE) \
+    X(JMP) X(JZ) X(JNZ) X(NEWARR_INT) X(NEWARR_FLOAT) X(ALOAD) X(ASTORE) \
+    X(VADD) X(VSUB) X(VMUL) X(VDIV) X(VCOPY) X(VFILL) X(VSUM) X(VMIN) X(VMAX) \
+    X(VDOT) X(ALEN) X(FOR_NEXT) X(CALL) X(SPAWN) X(JOIN) X(RETURN) X(MEMO) \
+    X(PURE) X(HALT)
+
+#define OPCODE_ENUM(name) OP_##name,
+#define OPCODE_NAME(name) #name,
+typedef enum { OPCODES(OPCODE_ENUM) OP_UNKNOWN } Opcode;
+const char* opcode_names[] = { OPCODES(OPCODE_NAME) };
+
 typedef struct {
     char opcode[32];
+    Opcode op;
     char arg[32];
     int arg_int;
     float arg_float;
+    char ext[3][32]; // FOR_NEXT: sinir, adim, hedef etiket
+    int ext_int[2];  // FOR_NEXT: sinir ve adim sabitse degeri
+    int ext_var[2];  // FOR_NEXT: sinir / adim degisken adi mi
+    int target;      // Atlama / cagri hedefi, yuklemede cozulur (yoksa -1)
 } Instruction;
 
 typedef struct {
@@ -31,224 +72,1295 @@ typedef struct {
     int addr;
 } Label;
 
-Instruction code[MAX_CODE];
-int code_size = 0;
-
-Label labels[MAX_LABELS];
-int label_count = 0;
-
-StackItem stack[MAX_STACK];
-int sp = -1;
-
 StackItem memory[MAX_MEMORY]; // Basit hafıza modeli (adresleme için sembol tablosu gerekebilir ama burada basit map kullanacağız)
 // VM'de değişken isimlerini adrese maplemek zor olabilir, o yüzden basit bir "isim -> değer" tablosu yapalım.
 typedef struct {
     char name[32];
     StackItem val;
+    int owned; // Dizi bu cerceveye mi ait (parametreyse cagirana ait)
 } Variable;
-Variable vars[MAX_MEMORY];
-int var_count = 0;
 
-int call_stack[MAX_CALL_STACK];
-int csp = -1;
+// --- MEMO ONBELLEGI ---
+typedef struct {
+    int used;
+    StackItem args[MAX_MEMO_ARGS];
+    StackItem result;
+} MemoEntry;
+
+typedef struct {
+    int func_addr;
+    int argc;
+    long hits, misses;
+    MemoEntry* entries; // MEMO_CACHE_SIZE elemanli
+} MemoTable;
+
+// --- PROGRAM ---
+// Yuklendikten sonra kod ve etiketler degismez; memo tablolari memo_lock
+// altinda buyur
+struct Program {
+    Instruction code[MAX_CODE];
+    int code_size;
+    Label labels[MAX_LABELS];
+    int label_count;
+    MemoTable memo_tables[MAX_MEMO_FUNCS];
+    int memo_table_count;
+    atomic_flag memo_lock; // Kisa kritik bolge: doner kilit
+};
+
+// Bir calistirma: ana baglam ve baslattigi gorevler ayni programi,
+// girdi/cikti akislarini ve sinirlari paylasir
+struct Exec {
+    Program* prog;
+    FILE* in;
+    FILE* out;
+    VmLimits limits;
+    int max_depth;
+    atomic_long steps_left; // Dagitilmamis adimlar (max_steps varsa)
+    atomic_long deadline;   // CLOCK_MONOTONIC ms, 0 ise yok
+    atomic_long memory;     // Canli dizi depolari, bayt
+    atomic_int stop;        // VM_OK degilse tum baglamlar bu hatayla durur
+    pthread_mutex_t limit_lock; // on_limit tek seferde bir kez cagrilir
+};
+
+// Sonucu beklenen (kacirilmis) cagrilar; call_memo bu diziye isaret eder
+typedef struct {
+    MemoTable* table;
+    StackItem args[MAX_MEMO_ARGS];
+    int ret_sp; // Donuste sonucun bulunacagi stack seviyesi
+} MemoPending;
+
+typedef struct Task Task;
+
+// --- YURUTME BAGLAMI ---
+// Ana program ve spawn edilen her gorev kendi yigini, degiskenleri ve
+// cagri yigini ile calisir; Exec (program, girdi, cikti) paylasilir.
+typedef struct VM {
+    StackItem stack[MAX_STACK];
+    int sp;
+    Variable vars[MAX_MEMORY];
+    int var_count;
+    int call_stack[MAX_CALL_STACK];
+    int frame_base[MAX_CALL_STACK]; // Her cagrinin yerel degiskenleri vars[frame_base..] araliginda
+    int call_memo[MAX_CALL_STACK];  // Cagri MEMO kacirmasiysa bekleyen kaydin indeksi, degilse -1
+    Task* frame_tasks[MAX_CALL_STACK + 1]; // Cercevenin bekleyen gorevleri (indeks csp + 1)
+    int csp;
+    int cur_base;
+    long fuel;            // Dilimden kalan adim; bitince refuel
+    MemoPending memo_pending[MAX_CALL_STACK];
+    Exec* exec;
+    Worker* worker;       // Bu baglami calistiran isci
+    struct VM* next_free; // Iscinin bos baglam listesi
+    jmp_buf* on_error;    // run_protected'in donus noktasi
+    VmStatus error_code;
+    char error[VM_ERROR_SIZE];
+} VM;
+
+// Hata: mesaj baglama yazilmistir, run_protected'a donulur
+_Noreturn void unwind(VM* vm, VmStatus code) {
+    vm->error_code = code;
+    longjmp(*vm->on_error, 1);
+}
+
+// Programin kendi hatalari
+_Noreturn void vm_error(VM* vm, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(vm->error, sizeof(vm->error), fmt, ap);
+    va_end(ap);
+    unwind(vm, VM_ERR_RUNTIME);
+}
+
+// Sinir asimlari ve iptal
+_Noreturn void vm_fail(VM* vm, VmStatus code, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(vm->error, sizeof(vm->error), fmt, ap);
+    va_end(ap);
+    unwind(vm, code);
+}
+
+void push(VM* vm, StackItem item) {
+    if (vm->sp >= MAX_STACK - 1) vm_error(vm, "Stack Overflow!");
+    vm->stack[++vm->sp] = item;
+}
+
+StackItem pop(VM* vm) {
+    if (vm->sp < 0) vm_error(vm, "Stack Underflow!");
+    return vm->stack[vm->sp--];
+}
+
+void push_call(VM* vm, int ret_addr) {
+    if (vm->csp >= vm->exec->max_depth - 1) {
+        if (vm->exec->max_depth < MAX_CALL_STACK) vm_fail(vm, VM_ERR_DEPTH, "Hata: Cagri derinligi siniri asildi (%d)", vm->exec->max_depth);
+        vm_error(vm, "Call Stack Overflow!");
+    }
+    vm->call_stack[++vm->csp] = ret_addr;
+    vm->frame_base[vm->csp] = vm->cur_base;
+    vm->call_memo[vm->csp] = -1;
+    vm->frame_tasks[vm->csp + 1] = NULL;
+    vm->cur_base = vm->var_count; // Yeni cerceve: yerel degiskenler buradan baslar
+}
+
+void free_array(VM* vm, Array* a);
+
+int pop_call(VM* vm) {
+    if (vm->csp < 0) vm_error(vm, "Call Stack Underflow!");
+    for (int i = vm->cur_base; i < vm->var_count; i++) {
+        if (vm->vars[i].owned) free_array(vm, vm->vars[i].val.val.arr);
+    }
+    vm->var_count = vm->cur_base; // Cagrinin yerellerini at
+    vm->cur_base = vm->frame_base[vm->csp];
+    return vm->call_stack[vm->csp--];
+}
+
+// --- MEMO YARDIMCILARI ---
+
+MemoTable* get_memo_table(Program* prog, int func_addr, int argc) {
+    for (int i = 0; i < prog->memo_table_count; i++) {
+        if (prog->memo_tables[i].func_addr == func_addr) return &prog->memo_tables[i];
+    }
+    if (prog->memo_table_count >= MAX_MEMO_FUNCS || argc > MAX_MEMO_ARGS) return NULL;
+    MemoTable* t = &prog->memo_tables[prog->memo_table_count++];
+    t->func_addr = func_addr;
+    t->argc = argc;
+    t->hits = t->misses = 0;
+    t->entries = (MemoEntry*)calloc(MEMO_CACHE_SIZE, sizeof(MemoEntry));
+    if (!t->entries) { printf("Bellek yetersiz!\n"); exit(1); }
+    return t;
+}
+
+int same_item(StackItem a, StackItem b) {
+    if (a.type != b.type) return 0;
+    if (a.type == TYPE_INT) return a.val.i_val == b.val.i_val;
+    return memcmp(&a.val.f_val, &b.val.f_val, sizeof(float)) == 0;
+}
 
-void push(StackItem item) {
-    if (sp >= MAX_STACK - 1) { printf("Stack Overflow!\n"); exit(1); }
-    stack[++sp] = item;
+unsigned int memo_hash(StackItem* args, int argc) {
+    unsigned int h = 2166136261u; // FNV-1a
+    for (int i = 0; i < argc; i++) {
+        unsigned int bits;
+        if (args[i].type == TYPE_INT) bits = (unsigned int)args[i].val.i_val;
+        else memcpy(&bits, &args[i].val.f_val, sizeof(bits));
+        h = (h ^ (unsigned int)args[i].type) * 16777619u;
+        for (int k = 0; k < 4; k++) { h = (h ^ (bits & 0xff)) * 16777619u; bits >>= 8; }
+    }
+    return h;
+}
+
+MemoEntry* memo_slot(MemoTable* t, StackItem* args) {
+    return &t->entries[memo_hash(args, t->argc) % MEMO_CACHE_SIZE];
 }
 
-StackItem pop() {
-    if (sp < 0) { printf("Stack Underflow!\n"); exit(1); }
-    return stack[sp--];
+int memo_match(MemoTable* t, MemoEntry* e, StackItem* args) {
+    if (!e->used) return 0;
+    for (int i = 0; i < t->argc; i++) {
+        if (!same_item(e->args[i], args[i])) return 0;
+    }
+    return 1;
 }
 
-void push_call(int ret_addr) {
-    if (csp >= MAX_CALL_STACK - 1) { printf("Call Stack Overflow!\n"); exit(1); }
-    call_stack[++csp] = ret_addr;
+const char* label_at(Program* prog, int addr) {
+    for (int i = 0; i < prog->label_count; i++) {
+        if (prog->labels[i].addr == addr && strncmp(prog->labels[i].name, "FUNC_", 5) == 0) return prog->labels[i].name;
+    }
+    return "?";
 }
 
-int pop_call() {
-    if (csp < 0) { printf("Call Stack Underflow!\n"); exit(1); }
-    return call_stack[csp--];
+void print_memo_stats(Program* prog) {
+    for (int i = 0; i < prog->memo_table_count; i++) {
+        fprintf(stderr, "MEMO %s: hit=%ld miss=%ld\n", label_at(prog, prog->memo_tables[i].func_addr),
+                prog->memo_tables[i].hits, prog->memo_tables[i].misses);
+    }
 }
 
-int find_label(char* name) {
-    for(int i=0; i<label_count; i++) {
-        if(strcmp(labels[i].name, name) == 0) return labels[i].addr;
+int find_label(Program* prog, char* name) {
+    for(int i=0; i<prog->label_count; i++) {
+        if(strcmp(prog->labels[i].name, name) == 0) return prog->labels[i].addr;
     }
     return -1;
 }
 
-int find_var(char* name) {
-    for(int i=0; i<var_count; i++) {
-        if(strcmp(vars[i].name, name) == 0) return i;
+int find_var(VM* vm, char* name) {
+    for(int i=vm->var_count-1; i>=vm->cur_base; i--) {
+        if(strcmp(vm->vars[i].name, name) == 0) return i;
     }
     return -1;
 }
 
-int add_var(char* name) {
-    int idx = find_var(name);
+// Tamsayi bolme / mod: sifira bolme hatadir, INT_MIN / -1 32 bit sarar
+// (SIMD yoluyla ayni); ikisi de donanimda SIGFPE olurdu
+int int_div(VM* vm, int a, int b, int mod) {
+    if (b == 0) vm_error(vm, "Hata: Sifira bolme");
+    if (b == -1) return mod ? 0 : (int)(0u - (unsigned int)a);
+    return mod ? a % b : a / b;
+}
+
+// FOR_NEXT islenleri: sabitler yuklemede cozulur, degiskenler cercevede aranir
+int int_operand(VM* vm, Instruction* instr, int k) {
+    if (!instr->ext_var[k]) return instr->ext_int[k];
+    int idx = find_var(vm, instr->ext[k]);
+    if (idx == -1) vm_error(vm, "Hata: Degisken bulunamadi %s", instr->ext[k]);
+    return vm->vars[idx].val.val.i_val;
+}
+
+int add_var(VM* vm, char* name) {
+    int idx = find_var(vm, name);
     if(idx != -1) return idx;
-    strcpy(vars[var_count].name, name);
-    vars[var_count].val.type = TYPE_INT;
-    vars[var_count].val.val.i_val = 0;
-    return var_count++;
+    strcpy(vm->vars[vm->var_count].name, name);
+    vm->vars[vm->var_count].val.type = TYPE_INT;
+    vm->vars[vm->var_count].val.val.i_val = 0;
+    vm->vars[vm->var_count].owned = 0;
+    return vm->var_count++;
+}
+
+// --- DIZILER ---
+
+#define ARRAY_ALIGN 32 // AVX2 yazmac genisligi
+
+size_t array_bytes(int cap) {
+    return ((size_t)cap * 4 + ARRAY_ALIGN - 1) / ARRAY_ALIGN * ARRAY_ALIGN;
+}
+
+// Calismanin bellek sayacina ekler; sinir asilirsa geri alip hata verir
+void charge_memory(VM* vm, long bytes) {
+    Exec* ex = vm->exec;
+    if (ex->limits.max_memory > 0 && atomic_fetch_add(&ex->memory, bytes) + bytes > ex->limits.max_memory) {
+        atomic_fetch_sub(&ex->memory, bytes);
+        vm_fail(vm, VM_ERR_MEMORY, "Hata: Bellek siniri asildi (%ld bayt)", ex->limits.max_memory);
+    }
+}
+
+void uncharge_memory(Exec* ex, long bytes) {
+    if (ex->limits.max_memory > 0) atomic_fetch_sub(&ex->memory, bytes);
+}
+
+// Kapasiteyi en az len yapar; eski icerik korunmaz (cagiranlar uzerine yazar)
+void array_reserve(VM* vm, Array* a, int len) {
+    if (len < 0) vm_error(vm, "Hata: Negatif dizi boyutu %d", len);
+    if (len > a->cap) {
+        void* data = NULL;
+        size_t bytes = array_bytes(len);
+        long grow = (long)(bytes - array_bytes(a->cap));
+        charge_memory(vm, grow);
+        if (posix_memalign(&data, ARRAY_ALIGN, bytes) != 0) {
+            uncharge_memory(vm->exec, grow);
+            vm_error(vm, "Bellek yetersiz!");
+        }
+        free(a->data);
+        a->data = data;
+        a->cap = len;
+    }
+    a->len = len;
+}
+
+void free_array(VM* vm, Array* a) {
+    uncharge_memory(vm->exec, (long)array_bytes(a->cap));
+    free(a->data);
+    free(a);
+}
+
+// Degiskene bu cercevenin sahip oldugu bos bir dizi bagla
+Array* attach_array(VM* vm, int idx) {
+    Array* a = (Array*)calloc(1, sizeof(Array));
+    if (!a) { printf("Bellek yetersiz!\n"); exit(1); }
+    a->elem = TYPE_INT;
+    vm->vars[idx].val.type = TYPE_ARRAY;
+    vm->vars[idx].val.val.arr = a;
+    vm->vars[idx].owned = 1;
+    return a;
+}
+
+// Isimli dizi degiskeni; toplu islemlerin hedefi yoksa bu cercevede olusturulur
+Array* named_array(VM* vm, char* name, int create) {
+    int idx = find_var(vm, name);
+    if (idx != -1 && vm->vars[idx].val.type == TYPE_ARRAY) return vm->vars[idx].val.val.arr;
+    if (!create) vm_error(vm, "Hata: Dizi bulunamadi %s", name);
+    return attach_array(vm, idx == -1 ? add_var(vm, name) : idx);
+}
+
+Array* pop_array(VM* vm) {
+    StackItem item = pop(vm);
+    if (item.type != TYPE_ARRAY) vm_error(vm, "Hata: Dizi bekleniyordu");
+    return item.val.arr;
+}
+
+int check_index(VM* vm, Array* a, StackItem idx, char* name) {
+    if (idx.val.i_val < 0 || idx.val.i_val >= a->len) {
+        vm_error(vm, "Hata: Dizi siniri asildi %s[%d] (boyut %d)", name, idx.val.i_val, a->len);
+    }
+    return idx.val.i_val;
+}
+
+// Eleman bazinda islem: islenenlerden biri skaler olabilir
+void array_binop(VM* vm, VecOp op, char* dst_name) {
+    StackItem b = pop(vm); StackItem a = pop(vm);
+    Array* x = a.type == TYPE_ARRAY ? a.val.arr : NULL;
+    Array* y = b.type == TYPE_ARRAY ? b.val.arr : NULL;
+    if (x && y && x->len != y->len) vm_error(vm, "Hata: Dizi boyutlari uyusmuyor (%d ve %d)", x->len, y->len);
+    DataType elem = x ? x->elem : y->elem;
+    int n = x ? x->len : y->len;
+    Array* dst = named_array(vm, dst_name, 1);
+    // Hedef bir islenenle ayni diziyse boyu zaten n'dir, depo yer degistirmez
+    array_reserve(vm, dst, n);
+    dst->elem = elem;
+    if (elem == TYPE_INT) {
+        if (vec_binop_i32(op, (int*)dst->data, x ? (int*)x->data : NULL, a.val.i_val,
+                          y ? (int*)y->data : NULL, b.val.i_val, n) != 0) {
+            vm_error(vm, "Hata: Sifira bolme");
+        }
+    } else {
+        vec_binop_f32(op, (float*)dst->data, x ? (float*)x->data : NULL, a.val.f_val,
+                      y ? (float*)y->data : NULL, b.val.f_val, n);
+    }
+}
+
+// sum / min / max / dot sonucunu yigina koyar
+void array_reduce(VM* vm, char* op, Array* a) {
+    StackItem res = {a->elem, .val.i_val = 0};
+    int is_min = strcmp(op, "VMIN") == 0, is_max = strcmp(op, "VMAX") == 0;
+    if ((is_min || is_max) && a->len == 0) vm_error(vm, "Hata: Bos dizide %s", is_min ? "min" : "max");
+    if (strcmp(op, "VDOT") == 0) {
+        Array* b = pop_array(vm);
+        if (b->len != a->len) vm_error(vm, "Hata: Dizi boyutlari uyusmuyor (%d ve %d)", a->len, b->len);
+        if (a->elem == TYPE_INT) res.val.i_val = vec_dot_i32((int*)a->data, (int*)b->data, a->len);
+        else res.val.f_val = vec_dot_f32((float*)a->data, (float*)b->data, a->len);
+    } else if (a->elem == TYPE_INT) {
+        if (is_min) res.val.i_val = vec_min_i32((int*)a->data, a->len);
+        else if (is_max) res.val.i_val = vec_max_i32((int*)a->data, a->len);
+        else res.val.i_val = vec_sum_i32((int*)a->data, a->len);
+    } else {
+        if (is_min) res.val.f_val = vec_min_f32((float*)a->data, a->len);
+        else if (is_max) res.val.f_val = vec_max_f32((float*)a->data, a->len);
+        else res.val.f_val = vec_sum_f32((float*)a->data, a->len);
+    }
+    push(vm, res);
+}
+
+// --- GOREV HAVUZU (WORK STEALING) ---
+// Her iscinin bir kuyrugu vardir: sahibi alttan ekleyip alttan alir (son
+// baslatilan gorev, onbellekte sicak), bos kalan isciler baska kuyruklarin
+// ustunden en eski (genelde en buyuk) gorevi calar. join'de bekleyen isci
+// bu arada kuyruklardaki gorevleri calistirir, boylece bloke olmaz.
+// submit_job isleri ayri bir FIFO'dadir ve yalnizca bos isciler alir: join'de
+// bekleyen bir isci baska bir baglantinin istegini (soket okumasi dahil)
+// ustlenip kendi isini geciktirmez.
+
+#define MAX_WORKERS 64
+#define DEQUE_SIZE 4096
+#define WAIT_SPINS 64 // wait_task uyumadan once kac kez yield eder
+#define MAX_TASK_ARGS 10
+
+struct Task {
+    Exec* exec;
+    int func_addr;
+    int argc;
+    StackItem args[MAX_TASK_ARGS];
+    StackItem result;
+    char dest[32];   // join'de sonucun yazilacagi degisken; "-" ise atilir
+    VmStatus error_code;
+    char error[VM_ERROR_SIZE]; // Bos degilse gorev hatayla bitti
+    atomic_int done;
+    Task* next;      // Ayni cercevede daha once baslatilan gorev
+    void (*job)(Worker* w, void* arg); // Fonksiyon yerine bagimsiz is (submit_job)
+    void* job_arg;
+};
+
+// Gorev basina bellek sinirina sayilan: Task ve gorevin calistigi baglam
+#define TASK_BYTES ((long)(sizeof(Task) + sizeof(VM)))
+
+struct Worker {
+    pthread_mutex_t lock;
+    Task* deque[DEQUE_SIZE]; // [top, bottom) arasi dolu
+    long top, bottom;
+    VM* free_vms;
+    unsigned int seed;
+    long spawned, stolen;
+    int in_use; // Havuz disi isci yuvasi bir is parcacigina bagli mi
+};
+
+// Havuz iscileri ve exec_run'i cagiran her is parcacigi (komut satiri,
+// gomulu kullanim) birer yuva alir; yuvalar pool_lock altinda eklenir,
+// sayac yuva hazirlandiktan sonra artar. Biten is parcaciginin yuvasi
+// (bos kuyruguyla) sonraki is parcacigina verilir.
+Worker workers[MAX_WORKERS];
+atomic_int worker_count;
+atomic_int pool_started;
+pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_key_t worker_key;
+pthread_once_t worker_key_once = PTHREAD_ONCE_INIT;
+atomic_int queued;    // Kuyruklardaki gorev sayisi (eklemeden once artar)
+atomic_int jobs_queued;
+Task* jobs_head = NULL; // submit_job FIFO'su, job_lock ile
+Task* jobs_tail = NULL;
+pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+atomic_int sleepers;
+pthread_mutex_t idle_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t idle_cond = PTHREAD_COND_INITIALIZER;
+atomic_int joiners;   // wait_task'ta uyuyanlar; gorev bitince ya da kuyruga
+pthread_cond_t join_cond = PTHREAD_COND_INITIALIZER; // is gelince uyanir (idle_lock ile)
+
+// Ayni Program'i gomulu kullanimda birden fazla is parcacigi havuz olmadan
+// da calistirabilir; memo onbellegi her zaman kilitlenir
+void memo_enter(Program* prog) {
+    while (atomic_flag_test_and_set_explicit(&prog->memo_lock, memory_order_acquire)) sched_yield();
+}
+void memo_leave(Program* prog) { atomic_flag_clear_explicit(&prog->memo_lock, memory_order_release); }
+
+int run_protected(VM* vm, int pc);
+
+// pool_lock altinda; yuvalar dolduysa NULL
+Worker* add_worker() {
+    int id = atomic_load(&worker_count);
+    if (id >= MAX_WORKERS) return NULL;
+    Worker* w = &workers[id];
+    pthread_mutex_init(&w->lock, NULL);
+    w->top = w->bottom = 0;
+    w->free_vms = NULL;
+    w->seed = (unsigned int)id * 2654435761u + 1;
+    w->spawned = w->stolen = 0;
+    w->in_use = 1;
+    atomic_store(&worker_count, id + 1);
+    return w;
+}
+
+void release_worker(void* arg) {
+    pthread_mutex_lock(&pool_lock);
+    ((Worker*)arg)->in_use = 0;
+    pthread_mutex_unlock(&pool_lock);
+}
+
+void create_worker_key() { pthread_key_create(&worker_key, release_worker); }
+
+// Cagiran is parcacigina ait isci; ilk cagrida serbest bir yuva alinir,
+// yuva kalmadiysa NULL
+Worker* main_worker() {
+    pthread_once(&worker_key_once, create_worker_key);
+    Worker* w = (Worker*)pthread_getspecific(worker_key);
+    if (w != NULL) return w;
+    pthread_mutex_lock(&pool_lock);
+    int n = atomic_load(&worker_count);
+    for (int i = 0; i < n && w == NULL; i++) {
+        if (!workers[i].in_use) w = &workers[i];
+    }
+    if (w != NULL) w->in_use = 1;
+    else w = add_worker();
+    pthread_mutex_unlock(&pool_lock);
+    if (w != NULL) pthread_setspecific(worker_key, w);
+    return w;
+}
+
+VM* acquire_vm(Worker* w, Exec* exec) {
+    VM* vm = w->free_vms;
+    if (vm != NULL) w->free_vms = vm->next_free;
+    else if ((vm = (VM*)malloc(sizeof(VM))) == NULL) { printf("Bellek yetersiz!\n"); exit(1); }
+    vm->sp = -1;
+    vm->var_count = 0;
+    vm->csp = -1;
+    vm->cur_base = 0;
+    vm->frame_tasks[0] = NULL;
+    vm->fuel = 0;
+    vm->exec = exec;
+    vm->worker = w;
+    vm->on_error = NULL;
+    vm->error_code = VM_OK;
+    vm->error[0] = '\0';
+    return vm;
+}
+
+// Kalan dizileri (ana cerceve ya da hatada yarim kalan cerceveler) ve
+// kullanilmayan adimlari birakir
+void release_vm(Worker* w, VM* vm) {
+    for (int i = 0; i < vm->var_count; i++) {
+        if (vm->vars[i].owned) free_array(vm, vm->vars[i].val.val.arr);
+    }
+    if (vm->exec->limits.max_steps > 0 && vm->fuel > 0) atomic_fetch_add(&vm->exec->steps_left, vm->fuel);
+    vm->next_free = w->free_vms;
+    w->free_vms = vm;
+}
+
+int deque_push(Worker* w, Task* t) {
+    pthread_mutex_lock(&w->lock);
+    int ok = w->bottom - w->top < DEQUE_SIZE;
+    if (ok) w->deque[w->bottom++ % DEQUE_SIZE] = t;
+    pthread_mutex_unlock(&w->lock);
+    return ok;
+}
+
+Task* deque_pop(Worker* w) {
+    pthread_mutex_lock(&w->lock);
+    Task* t = w->bottom > w->top ? w->deque[--w->bottom % DEQUE_SIZE] : NULL;
+    pthread_mutex_unlock(&w->lock);
+    return t;
+}
+
+Task* deque_steal(Worker* w) {
+    pthread_mutex_lock(&w->lock);
+    Task* t = w->bottom > w->top ? w->deque[w->top++ % DEQUE_SIZE] : NULL;
+    pthread_mutex_unlock(&w->lock);
+    return t;
+}
+
+// Once kendi kuyrugu, sonra rastgele bir kurbandan baslayarak digerleri
+Task* find_task(Worker* w) {
+    Task* t = deque_pop(w);
+    int n = atomic_load(&worker_count);
+    if (t == NULL && n > 1 && atomic_load(&queued) > 0) {
+        int start = rand_r(&w->seed) % n;
+        for (int i = 0; i < n && t == NULL; i++) {
+            Worker* victim = &workers[(start + i) % n];
+            if (victim != w) t = deque_steal(victim);
+        }
+        if (t != NULL) w->stolen++;
+    }
+    if (t != NULL) atomic_fetch_sub(&queued, 1);
+    return t;
+}
+
+void free_task(Task* t) {
+    uncharge_memory(t->exec, TASK_BYTES);
+    free(t);
+}
+
+void wake_joiners() {
+    if (atomic_load(&joiners) > 0) {
+        pthread_mutex_lock(&idle_lock);
+        pthread_cond_broadcast(&join_cond);
+        pthread_mutex_unlock(&idle_lock);
+    }
+}
+
+// Gorevi bu iscinin bos bir baglaminda bastan sona calistirir
+void run_task(Worker* w, Task* t) {
+    if (t->job != NULL) { // Kimse beklemez: is bitince birakilir
+        t->job(w, t->job_arg);
+        free(t);
+        return;
+    }
+    VM* vm = acquire_vm(w, t->exec);
+    memcpy(vm->stack, t->args, sizeof(StackItem) * t->argc);
+    vm->sp = t->argc - 1;
+    push_call(vm, -1); // Donus adresi yok: RETURN run'dan cikar
+    if (run_protected(vm, t->func_addr)) {
+        if (vm->sp >= 0) t->result = vm->stack[vm->sp];
+    } else {
+        t->error_code = vm->error_code;
+        strcpy(t->error, vm->error);
+    }
+    release_vm(w, vm);
+    atomic_store(&t->done, 1);
+    wake_joiners();
+}
+
+Task* take_job() {
+    if (atomic_load(&jobs_queued) == 0) return NULL;
+    pthread_mutex_lock(&job_lock);
+    Task* t = jobs_head;
+    if (t != NULL) {
+        jobs_head = t->next;
+        if (jobs_head == NULL) jobs_tail = NULL;
+        atomic_fetch_sub(&jobs_queued, 1);
+    }
+    pthread_mutex_unlock(&job_lock);
+    return t;
 }
 
-void load_program(const char* filename) {
-    FILE* f = fopen(filename, "r");
-    if (!f) { printf("Dosya acilamadi: %s\n", filename); exit(1); }
-    
+// Once baslamis isteklerin gorevleri, sonra yeni isler
+void* worker_main(void* arg) {
+    Worker* w = (Worker*)arg;
+    for (;;) {
+        Task* t = find_task(w);
+        if (t == NULL) t = take_job();
+        if (t != NULL) { run_task(w, t); continue; }
+        pthread_mutex_lock(&idle_lock);
+        atomic_fetch_add(&sleepers, 1);
+        while (atomic_load(&queued) == 0 && atomic_load(&jobs_queued) == 0) pthread_cond_wait(&idle_cond, &idle_lock);
+        atomic_fetch_sub(&sleepers, 1);
+        pthread_mutex_unlock(&idle_lock);
+    }
+    return NULL;
+}
+
+// Ilk spawn'da (sunucuda baslangicta) bir kez calisir; cagiran is parcacigi
+// da bir isci sayilir, toplam VM_THREADS ya da cekirdek sayisi kadar
+void start_pool(int reserved) {
+    pthread_mutex_lock(&pool_lock);
+    if (!atomic_load(&pool_started)) {
+        char* env = getenv("VM_THREADS");
+        int n = env ? atoi(env) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (n < 1) n = 1;
+        for (int i = 1; i < n + reserved; i++) {
+            Worker* w = add_worker();
+            pthread_t th;
+            if (w == NULL || pthread_create(&th, NULL, worker_main, w) != 0) break; // Kuyrugu bos kalir
+            pthread_detach(th);
+        }
+        atomic_store(&pool_started, 1);
+    }
+    pthread_mutex_unlock(&pool_lock);
+}
+
+void wake_worker() {
+    if (atomic_load(&sleepers) > 0) {
+        pthread_mutex_lock(&idle_lock);
+        pthread_cond_signal(&idle_cond);
+        pthread_mutex_unlock(&idle_lock);
+    }
+    wake_joiners();
+}
+
+// Gorevi w'nin kuyruguna koyar ve uyuyan bir isciyi uyandirir; kuyruk
+// doluysa 0 doner
+int enqueue(Worker* w, Task* t) {
+    atomic_fetch_add(&queued, 1);
+    if (!deque_push(w, t)) {
+        atomic_fetch_sub(&queued, 1);
+        return 0;
+    }
+    wake_worker();
+    return 1;
+}
+
+// SPAWN FUNC_f argc hedef: argumanlari yigindan alip gorevi kuyruga koyar
+void spawn_task(VM* vm, Instruction* instr) {
+    if (instr->target == -1) vm_error(vm, "Hata: Fonksiyon bulunamadi %s", instr->arg);
+    int argc = atoi(instr->ext[0]);
+    if (argc > MAX_TASK_ARGS) vm_error(vm, "Hata: Gorev icin cok fazla arguman");
+    if (!atomic_load(&pool_started)) start_pool(0);
+    charge_memory(vm, TASK_BYTES);
+    Task* t = (Task*)calloc(1, sizeof(Task));
+    if (!t) { printf("Bellek yetersiz!\n"); exit(1); }
+    t->exec = vm->exec;
+    t->func_addr = instr->target;
+    t->argc = argc;
+    for (int i = t->argc - 1; i >= 0; i--) t->args[i] = pop(vm);
+    strcpy(t->dest, instr->ext[1]);
+    t->next = vm->frame_tasks[vm->csp + 1];
+    vm->frame_tasks[vm->csp + 1] = t;
+
+    Worker* w = vm->worker;
+    w->spawned++;
+    if (!enqueue(w, t)) run_task(w, t); // Kuyruk dolu: hemen burada calistir
+}
+
+// Sunucu istekleri gibi bagimsiz isler gelis sirasiyla bos bir iscide calisir
+int submit_job(void (*job)(Worker* w, void* arg), void* arg) {
+    if (atomic_load(&jobs_queued) >= DEQUE_SIZE) return 0;
+    Task* t = (Task*)calloc(1, sizeof(Task));
+    if (!t) return 0;
+    t->job = job;
+    t->job_arg = arg;
+    pthread_mutex_lock(&job_lock);
+    if (jobs_tail != NULL) jobs_tail->next = t;
+    else jobs_head = t;
+    jobs_tail = t;
+    atomic_fetch_add(&jobs_queued, 1);
+    pthread_mutex_unlock(&job_lock);
+    wake_worker();
+    return 1;
+}
+
+// Gorev bitene kadar kuyruklardaki diger gorevleri calistirir. Is
+// bulunamazsa kisa bir sure yield eder, sonra gorev bitene ya da kuyruga
+// yeni gorev gelene kadar join_cond'da uyur.
+void wait_task(Worker* w, Task* t) {
+    int idle = 0;
+    while (!atomic_load(&t->done)) {
+        Task* other = find_task(w);
+        if (other != NULL) {
+            run_task(w, other);
+            idle = 0;
+        } else if (++idle < WAIT_SPINS) {
+            sched_yield();
+        } else {
+            pthread_mutex_lock(&idle_lock);
+            atomic_fetch_add(&joiners, 1);
+            while (!atomic_load(&t->done) && atomic_load(&queued) == 0) pthread_cond_wait(&join_cond, &idle_lock);
+            atomic_fetch_sub(&joiners, 1);
+            pthread_mutex_unlock(&idle_lock);
+            idle = 0;
+        }
+    }
+}
+
+// Cercevenin baslattigi gorevleri bekler; sonuclar baslatilma sirasiyla
+// yazilir (ayni hedefe iki gorev yazarsa sonuncusu kalir). Hatayla biten
+// bir gorev varsa digerleri de beklendikten sonra hata bu baglamda surer.
+void join_tasks(VM* vm) {
+    Task* t = vm->frame_tasks[vm->csp + 1];
+    if (t == NULL) return;
+    vm->frame_tasks[vm->csp + 1] = NULL;
+    Task* list = NULL;
+    while (t != NULL) { Task* next = t->next; t->next = list; list = t; t = next; }
+
+    char error[VM_ERROR_SIZE] = "";
+    VmStatus code = VM_OK;
+    while (list != NULL) {
+        t = list;
+        wait_task(vm->worker, t);
+        if (t->error[0] != '\0') {
+            if (code == VM_OK) { code = t->error_code; strcpy(error, t->error); }
+        } else if (strcmp(t->dest, "-") != 0) {
+            vm->vars[add_var(vm, t->dest)].val = t->result;
+        }
+        list = t->next;
+        free_task(t);
+    }
+    if (code != VM_OK) vm_fail(vm, code, "%s", error);
+}
+
+void print_task_stats() {
+    long spawned = 0, stolen = 0;
+    int n = atomic_load(&worker_count);
+    for (int i = 0; i < n; i++) {
+        spawned += workers[i].spawned;
+        stolen += workers[i].stolen;
+    }
+    fprintf(stderr, "Gorev: spawn=%ld steal=%ld isci=%d\n", spawned, stolen, n);
+}
+
+// --- SINIRLAR ---
+// Sicak yolda yalnizca baglamin yerel yakiti (fuel) azalir: geriye
+// atlamada, cagrida ve spawn'da. Dilim bitince refuel ortak butceden yeni
+// dilim alir, sureye ve iptal bayragina bakar.
+
+long now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000;
+}
+
+// Asilan sinir icin on_limit'e sorar; ek verilmezse calismayi durdurur.
+// Kilit altinda yeniden bakilir: baska bir baglam bu arada uzatmis olabilir.
+void extend_limit(Exec* ex, VmStatus which) {
+    pthread_mutex_lock(&ex->limit_lock);
+    int ok = which == VM_ERR_STEPS ? atomic_load(&ex->steps_left) > 0 : now_ms() < atomic_load(&ex->deadline);
+    if (!ok && atomic_load(&ex->stop) == VM_OK && ex->limits.on_limit != NULL) {
+        long extra = ex->limits.on_limit(ex, which, ex->limits.user);
+        if (extra > 0) {
+            if (which == VM_ERR_STEPS) atomic_store(&ex->steps_left, extra);
+            else atomic_store(&ex->deadline, now_ms() + extra);
+            ok = 1;
+        }
+    }
+    if (!ok) {
+        int running = VM_OK;
+        atomic_compare_exchange_strong(&ex->stop, &running, (int)which);
+    }
+    pthread_mutex_unlock(&ex->limit_lock);
+}
+
+void refuel(VM* vm) {
+    Exec* ex = vm->exec;
+    for (;;) {
+        VmStatus stop = (VmStatus)atomic_load(&ex->stop);
+        if (stop == VM_ERR_STEPS) vm_fail(vm, stop, "Hata: Adim siniri asildi (%ld)", ex->limits.max_steps);
+        if (stop == VM_ERR_TIME) vm_fail(vm, stop, "Hata: Sure siniri asildi (%ld ms)", ex->limits.max_time_ms);
+        if (stop != VM_OK) vm_fail(vm, stop, "Hata: Calisma iptal edildi");
+
+        long deadline = atomic_load(&ex->deadline);
+        if (deadline != 0 && now_ms() >= deadline) { extend_limit(ex, VM_ERR_TIME); continue; }
+        if (ex->limits.max_steps <= 0) { vm->fuel = FUEL_SLICE; return; }
+        long left = atomic_fetch_sub(&ex->steps_left, FUEL_SLICE);
+        if (left > 0) {
+            vm->fuel = left < FUEL_SLICE ? left : FUEL_SLICE;
+            if (left < FUEL_SLICE) atomic_fetch_add(&ex->steps_left, FUEL_SLICE - left); // Sifirda tut
+            return;
+        }
+        atomic_fetch_add(&ex->steps_left, FUEL_SLICE);
+        extend_limit(ex, VM_ERR_STEPS);
+    }
+}
+
+void free_program(Program* prog) {
+    for (int i = 0; i < prog->memo_table_count; i++) free(prog->memo_tables[i].entries);
+    free(prog);
+}
+
+int is_branch(Opcode op) {
+    return op == OP_JMP || op == OP_JZ || op == OP_JNZ || op == OP_CALL || op == OP_SPAWN || op == OP_FOR_NEXT;
+}
+
+Opcode find_opcode(const char* name) {
+    for (int i = 0; i < OP_UNKNOWN; i++) {
+        if (strcmp(opcode_names[i], name) == 0) return (Opcode)i;
+    }
+    return OP_UNKNOWN;
+}
+
+Program* load_program(FILE* f, char* err) {
+    Program* prog = (Program*)calloc(1, sizeof(Program));
+    if (!prog) { strcpy(err, "Bellek yetersiz!"); return NULL; }
+    atomic_flag_clear(&prog->memo_lock);
+
     char line[128];
     while(fgets(line, sizeof(line), f)) {
-        char op[32], arg[32];
-        int n = sscanf(line, "%s %s", op, arg);
+        char op[32], arg[32], ext[3][32];
+        int n = sscanf(line, "%31s %31s %31s %31s %31s", op, arg, ext[0], ext[1], ext[2]);
         
         if (n > 0) {
             // Label mı?
             if (op[strlen(op)-1] == ':') {
+                if (prog->label_count >= MAX_LABELS) { strcpy(err, "Hata: Cok fazla etiket"); free_program(prog); return NULL; }
                 op[strlen(op)-1] = '\0';
-                strcpy(labels[label_count].name, op);
-                labels[label_count].addr = code_size;
-                label_count++;
+                strcpy(prog->labels[prog->label_count].name, op);
+                prog->labels[prog->label_count].addr = prog->code_size;
+                prog->label_count++;
             } else {
-                strcpy(code[code_size].opcode, op);
+                if (prog->code_size >= MAX_CODE) { strcpy(err, "Hata: Program cok buyuk"); free_program(prog); return NULL; }
+                Instruction* instr = &prog->code[prog->code_size];
+                strcpy(instr->opcode, op);
                 if (n > 1) {
-                    strcpy(code[code_size].arg, arg);
-                    if (strcmp(op, "PUSH_INT") == 0) code[code_size].arg_int = atoi(arg);
-                    else if (strcmp(op, "PUSH_FLOAT") == 0) code[code_size].arg_float = atof(arg);
+                    strcpy(instr->arg, arg);
+                    if (strcmp(op, "PUSH_INT") == 0 || strcmp(op, "MEMO") == 0 || strcmp(op, "PURE") == 0) instr->arg_int = atoi(arg);
+                    else if (strcmp(op, "PUSH_FLOAT") == 0) instr->arg_float = atof(arg);
                 }
-                code_size++;
+                for (int k = 0; k + 2 < n; k++) strcpy(instr->ext[k], ext[k]);
+                prog->code_size++;
             }
         }
     }
-    fclose(f);
+
+    // Komutlar ve etiketler bir kez cozulur; calisirken atlamalar isim aramaz
+    for (int i = 0; i < prog->code_size; i++) {
+        Instruction* instr = &prog->code[i];
+        instr->op = find_opcode(instr->opcode);
+        instr->target = -1;
+        if (is_branch(instr->op)) {
+            instr->target = find_label(prog, instr->op == OP_FOR_NEXT ? instr->ext[2] : instr->arg);
+        }
+        if (instr->op == OP_FOR_NEXT) {
+            for (int k = 0; k < 2; k++) {
+                char* tok = instr->ext[k];
+                instr->ext_var[k] = !(tok[0] == '-' || (tok[0] >= '0' && tok[0] <= '9'));
+                instr->ext_int[k] = instr->ext_var[k] ? 0 : atoi(tok);
+            }
+        }
+    }
+    return prog;
 }
 
-void run() {
-    int pc = 0;
-    while(pc < code_size) {
-        Instruction* instr = &code[pc];
+void run(VM* vm, int pc) {
+    Program* prog = vm->exec->prog;
+    while(pc < prog->code_size) {
+        Instruction* instr = &prog->code[pc];
         // printf("PC: %d, OP: %s, ARG: %s\n", pc, instr->opcode, instr->arg); // Debug
 
-        if (strcmp(instr->opcode, "PUSH_INT") == 0) {
-            StackItem item = {TYPE_INT, .val.i_val = instr->arg_int};
-            push(item);
-        } else if (strcmp(instr->opcode, "PUSH_FLOAT") == 0) {
-            StackItem item = {TYPE_FLOAT, .val.f_val = instr->arg_float};
-            push(item);
-        } else if (strcmp(instr->opcode, "ADD") == 0) {
-            StackItem b = pop(); StackItem a = pop();
-            StackItem res = {a.type, .val.i_val = 0};
-            if (a.type == TYPE_INT) res.val.i_val = a.val.i_val + b.val.i_val;
-            else res.val.f_val = a.val.f_val + b.val.f_val;
-            push(res);
-        } else if (strcmp(instr->opcode, "SUB") == 0) {
-            StackItem b = pop(); StackItem a = pop();
-            StackItem res = {a.type, .val.i_val = 0};
-            if (a.type == TYPE_INT) res.val.i_val = a.val.i_val - b.val.i_val;
-            else res.val.f_val = a.val.f_val - b.val.f_val;
-            push(res);
-        } else if (strcmp(instr->opcode, "MUL") == 0) {
-            StackItem b = pop(); StackItem a = pop();
-            StackItem res = {a.type, .val.i_val = 0};
-            if (a.type == TYPE_INT) res.val.i_val = a.val.i_val * b.val.i_val;
-            else res.val.f_val = a.val.f_val * b.val.f_val;
-            push(res);
-        } else if (strcmp(instr->opcode, "DIV") == 0) {
-            StackItem b = pop(); StackItem a = pop();
-            StackItem res = {a.type, .val.i_val = 0};
-            if (a.type == TYPE_INT) res.val.i_val = a.val.i_val / b.val.i_val;
-            else res.val.f_val = a.val.f_val / b.val.f_val;
-            push(res);
-        } else if (strcmp(instr->opcode, "MOD") == 0) {
-            StackItem b = pop(); StackItem a = pop();
-            StackItem res = {TYPE_INT, .val.i_val = 0};
-            if (a.type == TYPE_INT) res.val.i_val = a.val.i_val % b.val.i_val;
-            else res.val.i_val = (int)a.val.f_val % (int)b.val.f_val; // Float mod? Cast to int for now
-            push(res);
-        } else if (strcmp(instr->opcode, "POW") == 0) {
-            StackItem b = pop(); StackItem a = pop();
-            StackItem res = {a.type, .val.i_val = 0};
-            if (a.type == TYPE_INT) res.val.i_val = (int)pow(a.val.i_val, b.val.i_val);
-            else res.val.f_val = powf(a.val.f_val, b.val.f_val);
-            push(res);
-        } else if (strcmp(instr->opcode, "GT") == 0) {
-            StackItem b = pop(); StackItem a = pop();
-            StackItem res = {TYPE_INT, .val.i_val = 0};
-            if (a.type == TYPE_INT) res.val.i_val = a.val.i_val > b.val.i_val;
-            else res.val.i_val = a.val.f_val > b.val.f_val;
-            push(res);
-        } else if (strcmp(instr->opcode, "LT") == 0) {
-            StackItem b = pop(); StackItem a = pop();
-            StackItem res = {TYPE_INT, .val.i_val = 0};
-            if (a.type == TYPE_INT) res.val.i_val = a.val.i_val < b.val.i_val;
-            else res.val.i_val = a.val.f_val < b.val.f_val;
-            push(res);
-        } else if (strcmp(instr->opcode, "EQ") == 0) {
-            StackItem b = pop(); StackItem a = pop();
-            StackItem res = {TYPE_INT, .val.i_val = 0};
-            if (a.type == TYPE_INT) res.val.i_val = a.val.i_val == b.val.i_val;
-            else res.val.i_val = a.val.f_val == b.val.f_val;
-            push(res);
-        } else if (strcmp(instr->opcode, "NEQ") == 0) {
-            StackItem b = pop(); StackItem a = pop();
-            StackItem res = {TYPE_INT, .val.i_val = 0};
-            if (a.type == TYPE_INT) res.val.i_val = a.val.i_val != b.val.i_val;
-            else res.val.i_val = a.val.f_val != b.val.f_val;
-            push(res);
-        } else if (strcmp(instr->opcode, "PRINT") == 0) {
-            StackItem item = pop();
-            if (item.type == TYPE_INT) printf("%d\n", item.val.i_val);
-            else printf("%f\n", item.val.f_val);
-        } else if (strcmp(instr->opcode, "STORE") == 0) {
-            int idx = add_var(instr->arg);
-            vars[idx].val = pop();
-        } else if (strcmp(instr->opcode, "LOAD") == 0) {
-            int idx = find_var(instr->arg);
-            if (idx == -1) { printf("Hata: Degisken bulunamadi %s\n", instr->arg); exit(1); }
-            push(vars[idx].val);
-        } else if (strcmp(instr->opcode, "DECLARE") == 0) {
-            add_var(instr->arg);
-        } else if (strcmp(instr->opcode, "JMP") == 0) {
-            int addr = find_label(instr->arg);
-            if (addr == -1) { printf("Hata: Label bulunamadi %s\n", instr->arg); exit(1); }
-            pc = addr; continue;
-        } else if (strcmp(instr->opcode, "JZ") == 0) {
-            StackItem item = pop();
-            int val = (item.type == TYPE_INT) ? item.val.i_val : (int)item.val.f_val;
-            if (val == 0) {
-                int addr = find_label(instr->arg);
-                if (addr == -1) { printf("Hata: Label bulunamadi %s\n", instr->arg); exit(1); }
-                pc = addr; continue;
+        switch (instr->op) {
+            case OP_PUSH_INT: {
+                StackItem item = {TYPE_INT, .val.i_val = instr->arg_int};
+                push(vm, item);
+                break;
+            }
+            case OP_PUSH_FLOAT: {
+                StackItem item = {TYPE_FLOAT, .val.f_val = instr->arg_float};
+                push(vm, item);
+                break;
+            }
+            case OP_ADD: {
+                StackItem b = pop(vm); StackItem a = pop(vm);
+                StackItem res = {a.type, .val.i_val = 0};
+                if (a.type == TYPE_INT) res.val.i_val = a.val.i_val + b.val.i_val;
+                else res.val.f_val = a.val.f_val + b.val.f_val;
+                push(vm, res);
+                break;
+            }
+            case OP_SUB: {
+                StackItem b = pop(vm); StackItem a = pop(vm);
+                StackItem res = {a.type, .val.i_val = 0};
+                if (a.type == TYPE_INT) res.val.i_val = a.val.i_val - b.val.i_val;
+                else res.val.f_val = a.val.f_val - b.val.f_val;
+                push(vm, res);
+                break;
+            }
+            case OP_MUL: {
+                StackItem b = pop(vm); StackItem a = pop(vm);
+                StackItem res = {a.type, .val.i_val = 0};
+                if (a.type == TYPE_INT) res.val.i_val = a.val.i_val * b.val.i_val;
+                else res.val.f_val = a.val.f_val * b.val.f_val;
+                push(vm, res);
+                break;
             }
-        } else if (strcmp(instr->opcode, "JNZ") == 0) {
-            StackItem item = pop();
-            int val = (item.type == TYPE_INT) ? item.val.i_val : (int)item.val.f_val;
-            if (val != 0) {
-                int addr = find_label(instr->arg);
-                if (addr == -1) { printf("Hata: Label bulunamadi %s\n", instr->arg); exit(1); }
+            case OP_DIV: {
+                StackItem b = pop(vm); StackItem a = pop(vm);
+                StackItem res = {a.type, .val.i_val = 0};
+                if (a.type == TYPE_INT) res.val.i_val = int_div(vm, a.val.i_val, b.val.i_val, 0);
+                else res.val.f_val = a.val.f_val / b.val.f_val;
+                push(vm, res);
+                break;
+            }
+            case OP_MOD: {
+                StackItem b = pop(vm); StackItem a = pop(vm);
+                StackItem res = {TYPE_INT, .val.i_val = 0};
+                if (a.type == TYPE_INT) res.val.i_val = int_div(vm, a.val.i_val, b.val.i_val, 1);
+                else res.val.i_val = int_div(vm, (int)a.val.f_val, (int)b.val.f_val, 1); // Float mod? Cast to int for now
+                push(vm, res);
+                break;
+            }
+            case OP_POW: {
+                StackItem b = pop(vm); StackItem a = pop(vm);
+                StackItem res = {a.type, .val.i_val = 0};
+                if (a.type == TYPE_INT) res.val.i_val = (int)pow(a.val.i_val, b.val.i_val);
+                else res.val.f_val = powf(a.val.f_val, b.val.f_val);
+                push(vm, res);
+                break;
+            }
+            case OP_GT: {
+                StackItem b = pop(vm); StackItem a = pop(vm);
+                StackItem res = {TYPE_INT, .val.i_val = 0};
+                if (a.type == TYPE_INT) res.val.i_val = a.val.i_val > b.val.i_val;
+                else res.val.i_val = a.val.f_val > b.val.f_val;
+                push(vm, res);
+                break;
+            }
+            case OP_LT: {
+                StackItem b = pop(vm); StackItem a = pop(vm);
+                StackItem res = {TYPE_INT, .val.i_val = 0};
+                if (a.type == TYPE_INT) res.val.i_val = a.val.i_val < b.val.i_val;
+                else res.val.i_val = a.val.f_val < b.val.f_val;
+                push(vm, res);
+                break;
+            }
+            case OP_EQ: {
+                StackItem b = pop(vm); StackItem a = pop(vm);
+                StackItem res = {TYPE_INT, .val.i_val = 0};
+                if (a.type == TYPE_INT) res.val.i_val = a.val.i_val == b.val.i_val;
+                else res.val.i_val = a.val.f_val == b.val.f_val;
+                push(vm, res);
+                break;
+            }
+            case OP_NEQ: {
+                StackItem b = pop(vm); StackItem a = pop(vm);
+                StackItem res = {TYPE_INT, .val.i_val = 0};
+                if (a.type == TYPE_INT) res.val.i_val = a.val.i_val != b.val.i_val;
+                else res.val.i_val = a.val.f_val != b.val.f_val;
+                push(vm, res);
+                break;
+            }
+            case OP_PRINT: {
+                StackItem item = pop(vm);
+                if (item.type == TYPE_INT) fprintf(vm->exec->out, "%d\n", item.val.i_val);
+                else fprintf(vm->exec->out, "%f\n", item.val.f_val);
+                break;
+            }
+            case OP_READ: {
+                // READ x INT|FLOAT: girdiden bosluklarla ayrilmis bir sayi
+                int idx = add_var(vm, instr->arg);
+                StackItem item = {TYPE_INT, .val.i_val = 0};
+                int n;
+                if (strcmp(instr->ext[0], "FLOAT") == 0) {
+                    item.type = TYPE_FLOAT;
+                    n = fscanf(vm->exec->in, "%f", &item.val.f_val);
+                } else {
+                    n = fscanf(vm->exec->in, "%d", &item.val.i_val);
+                }
+                if (n != 1) vm_error(vm, "Hata: Girdi okunamadi %s", instr->arg);
+                vm->vars[idx].val = item;
+                break;
+            }
+            case OP_STORE: {
+                int idx = add_var(vm, instr->arg);
+                vm->vars[idx].val = pop(vm);
+                break;
+            }
+            case OP_LOAD: {
+                int idx = find_var(vm, instr->arg);
+                if (idx == -1) vm_error(vm, "Hata: Degisken bulunamadi %s", instr->arg);
+                push(vm, vm->vars[idx].val);
+                break;
+            }
+            case OP_DECLARE: {
+                add_var(vm, instr->arg);
+                break;
+            }
+            case OP_JMP: {
+                if (instr->target == -1) vm_error(vm, "Hata: Label bulunamadi %s", instr->arg);
+                if (instr->target <= pc && --vm->fuel <= 0) refuel(vm);
+                pc = instr->target; continue;
+            }
+            case OP_JZ: {
+                StackItem item = pop(vm);
+                int val = (item.type == TYPE_INT) ? item.val.i_val : (int)item.val.f_val;
+                if (val == 0) {
+                    if (instr->target == -1) vm_error(vm, "Hata: Label bulunamadi %s", instr->arg);
+                    if (instr->target <= pc && --vm->fuel <= 0) refuel(vm);
+                    pc = instr->target; continue;
+                }
+                break;
+            }
+            case OP_JNZ: {
+                StackItem item = pop(vm);
+                int val = (item.type == TYPE_INT) ? item.val.i_val : (int)item.val.f_val;
+                if (val != 0) {
+                    if (instr->target == -1) vm_error(vm, "Hata: Label bulunamadi %s", instr->arg);
+                    if (instr->target <= pc && --vm->fuel <= 0) refuel(vm);
+                    pc = instr->target; continue;
+                }
+                break;
+            }
+            case OP_NEWARR_INT: case OP_NEWARR_FLOAT: {
+                // Tanim: bu cercevede sifirlanmis yeni dizi (parametreyi golgeliyorsa ona dokunmaz)
+                StackItem size = pop(vm);
+                int idx = find_var(vm, instr->arg);
+                Array* a = (idx != -1 && vm->vars[idx].owned) ? vm->vars[idx].val.val.arr
+                                                          : attach_array(vm, idx == -1 ? add_var(vm, instr->arg) : idx);
+                array_reserve(vm, a, size.val.i_val);
+                a->elem = instr->opcode[7] == 'I' ? TYPE_INT : TYPE_FLOAT;
+                memset(a->data, 0, (size_t)a->len * 4);
+                break;
+            }
+            case OP_ALOAD: {
+                Array* a = named_array(vm, instr->arg, 0);
+                int i = check_index(vm, a, pop(vm), instr->arg);
+                StackItem item = {a->elem, .val.i_val = 0};
+                if (a->elem == TYPE_INT) item.val.i_val = ((int*)a->data)[i];
+                else item.val.f_val = ((float*)a->data)[i];
+                push(vm, item);
+                break;
+            }
+            case OP_ASTORE: {
+                Array* a = named_array(vm, instr->arg, 0);
+                StackItem val = pop(vm);
+                int i = check_index(vm, a, pop(vm), instr->arg);
+                if (a->elem == TYPE_INT) ((int*)a->data)[i] = val.val.i_val;
+                else ((float*)a->data)[i] = val.val.f_val;
+                break;
+            }
+            case OP_VADD: {
+                array_binop(vm, VEC_ADD, instr->arg);
+                break;
+            }
+            case OP_VSUB: {
+                array_binop(vm, VEC_SUB, instr->arg);
+                break;
+            }
+            case OP_VMUL: {
+                array_binop(vm, VEC_MUL, instr->arg);
+                break;
+            }
+            case OP_VDIV: {
+                array_binop(vm, VEC_DIV, instr->arg);
+                break;
+            }
+            case OP_VCOPY: {
+                Array* src = pop_array(vm);
+                Array* dst = named_array(vm, instr->arg, 1);
+                if (dst != src) {
+                    array_reserve(vm, dst, src->len);
+                    dst->elem = src->elem;
+                    memcpy(dst->data, src->data, (size_t)src->len * 4);
+                }
+                break;
+            }
+            case OP_VFILL: {
+                StackItem val = pop(vm);
+                Array* a = named_array(vm, instr->arg, 0);
+                if (a->elem == TYPE_INT) vec_fill_i32((int*)a->data, val.val.i_val, a->len);
+                else vec_fill_f32((float*)a->data, val.val.f_val, a->len);
+                break;
+            }
+            case OP_VSUM: case OP_VMIN: case OP_VMAX: case OP_VDOT: {
+                array_reduce(vm, instr->opcode, named_array(vm, instr->arg, 0));
+                break;
+            }
+            case OP_ALEN: {
+                StackItem item = {TYPE_INT, .val.i_val = named_array(vm, instr->arg, 0)->len};
+                push(vm, item);
+                break;
+            }
+            case OP_FOR_NEXT: {
+                // Sayaci adim kadar ilerlet; sinir asilmadiysa govdeye don
+                int idx = find_var(vm, instr->arg);
+                if (idx == -1) vm_error(vm, "Hata: Degisken bulunamadi %s", instr->arg);
+                int limit = int_operand(vm, instr, 0);
+                int step = int_operand(vm, instr, 1);
+                if (step == 0) vm_error(vm, "Hata: Dongu adimi 0 olamaz");
+                // INT_MAX / INT_MIN yakininda tasma: sayac sarar, dongu biter
+                long long val = (long long)vm->vars[idx].val.val.i_val + step;
+                vm->vars[idx].val.val.i_val = (int)(unsigned int)val;
+                if (step > 0 ? val <= limit : val >= limit) {
+                    if (instr->target == -1) vm_error(vm, "Hata: Label bulunamadi %s", instr->ext[2]);
+                    if (--vm->fuel <= 0) refuel(vm);
+                    pc = instr->target; continue;
+                }
+                break;
+            }
+            case OP_CALL: {
+                int addr = instr->target;
+                if (addr == -1) vm_error(vm, "Hata: Fonksiyon bulunamadi %s", instr->arg);
+                if (--vm->fuel <= 0) refuel(vm);
+                MemoTable* t = NULL;
+                int hit = 0;
+                StackItem result;
+                if (addr < prog->code_size && prog->code[addr].op == OP_MEMO && vm->sp + 1 >= prog->code[addr].arg_int) {
+                    memo_enter(prog);
+                    t = get_memo_table(prog, addr, prog->code[addr].arg_int);
+                    if (t != NULL) {
+                        StackItem* args = &vm->stack[vm->sp - t->argc + 1];
+                        MemoEntry* e = memo_slot(t, args);
+                        hit = memo_match(t, e, args);
+                        if (hit) { t->hits++; result = e->result; }
+                        else t->misses++;
+                    }
+                    memo_leave(prog);
+                }
+                if (hit) {
+                    vm->sp -= t->argc;
+                    push(vm, result);
+                    pc++; continue;
+                }
+                push_call(vm, pc + 1);
+                if (t != NULL) {
+                    MemoPending* mp = &vm->memo_pending[vm->csp];
+                    mp->table = t;
+                    memcpy(mp->args, &vm->stack[vm->sp - t->argc + 1], sizeof(StackItem) * t->argc);
+                    mp->ret_sp = vm->sp - t->argc + 1;
+                    vm->call_memo[vm->csp] = vm->csp;
+                }
                 pc = addr; continue;
             }
-        } else if (strcmp(instr->opcode, "CALL") == 0) {
-            int addr = find_label(instr->arg);
-            if (addr == -1) { printf("Hata: Fonksiyon bulunamadi %s\n", instr->arg); exit(1); }
-            push_call(pc + 1);
-            pc = addr; continue;
-        } else if (strcmp(instr->opcode, "RETURN") == 0) {
-            int ret_addr = pop_call();
-            pc = ret_addr; continue;
-        } else if (strcmp(instr->opcode, "HALT") == 0) {
-            break;
+            case OP_SPAWN: {
+                if (--vm->fuel <= 0) refuel(vm);
+                spawn_task(vm, instr);
+                break;
+            }
+            case OP_JOIN: {
+                join_tasks(vm);
+                break;
+            }
+            case OP_RETURN: {
+                join_tasks(vm); // Gorevler cercevelerinden uzun yasamaz
+                if (vm->csp >= 0 && vm->call_memo[vm->csp] != -1) {
+                    MemoPending* mp = &vm->memo_pending[vm->call_memo[vm->csp]];
+                    if (vm->sp == mp->ret_sp) { // Tam bir donus degeri birakildiysa kaydet
+                        memo_enter(prog);
+                        MemoEntry* e = memo_slot(mp->table, mp->args);
+                        memcpy(e->args, mp->args, sizeof(StackItem) * mp->table->argc);
+                        e->result = vm->stack[vm->sp];
+                        e->used = 1;
+                        memo_leave(prog);
+                    }
+                }
+                int ret_addr = pop_call(vm);
+                if (ret_addr < 0) return; // Gorevin giris cercevesi
+                pc = ret_addr; continue;
+            }
+            case OP_MEMO: case OP_PURE: {
+                // Isaret: onbellek kontrolu CALL sirasinda yapilir
+                break;
+            }
+            case OP_HALT: {
+                join_tasks(vm);
+                return;
+            }
+            default: // Bilinmeyen komutlar atlanir
+                break;
         }
         
         pc++;
     }
+    join_tasks(vm); // Kodun sonu
+}
+
+// run'i hata yakalayarak calistirir. Hatada bekleyen gorevler (sonuclari
+// atilarak) beklenir ve 0 doner; mesaj vm->error'dadir.
+int run_protected(VM* vm, int pc) {
+    jmp_buf env;
+    vm->on_error = &env;
+    if (setjmp(env) != 0) {
+        for (int level = vm->csp + 1; level >= 0; level--) {
+            Task* t = vm->frame_tasks[level];
+            vm->frame_tasks[level] = NULL;
+            while (t != NULL) {
+                Task* next = t->next;
+                wait_task(vm->worker, t);
+                free_task(t);
+                t = next;
+            }
+        }
+        return 0;
+    }
+    run(vm, pc);
+    return 1;
 }
 
+Exec* exec_create(Program* prog, FILE* in, FILE* out, const VmLimits* limits) {
+    Exec* ex = (Exec*)calloc(1, sizeof(Exec));
+    if (!ex) return NULL;
+    ex->prog = prog;
+    ex->in = in;
+    ex->out = out;
+    if (limits != NULL) ex->limits = *limits;
+    ex->max_depth = ex->limits.max_depth > 0 && ex->limits.max_depth < MAX_CALL_STACK ? ex->limits.max_depth : MAX_CALL_STACK;
+    atomic_init(&ex->steps_left, ex->limits.max_steps);
+    pthread_mutex_init(&ex->limit_lock, NULL);
+    return ex;
+}
+
+VmStatus exec_run(Exec* ex, Worker* w, VmError* err) {
+    if (w == NULL && (w = main_worker()) == NULL) {
+        if (err != NULL) { err->code = VM_ERR_RUNTIME; strcpy(err->message, "Hata: Cok fazla is parcacigi"); }
+        return VM_ERR_RUNTIME;
+    }
+    if (ex->limits.max_time_ms > 0) atomic_store(&ex->deadline, now_ms() + ex->limits.max_time_ms);
+    VM* vm = acquire_vm(w, ex);
+    VmStatus status = run_protected(vm, 0) ? VM_OK : vm->error_code;
+    if (status != VM_OK && err != NULL) {
+        err->code = status;
+        strcpy(err->message, vm->error);
+    }
+    release_vm(w, vm);
+    return status;
+}
+
+void exec_abort(Exec* ex) {
+    int running = VM_OK;
+    atomic_compare_exchange_strong(&ex->stop, &running, (int)VM_ERR_ABORTED);
+}
+
+void exec_free(Exec* ex) {
+    pthread_mutex_destroy(&ex->limit_lock);
+    free(ex);
+}
+
+#ifndef VM_NO_MAIN
 int main(int argc, char* argv[]) {
-    if (argc < 2) { printf("Kullanim: %s <bytecode_file>\n", argv[0]); return 1; }
-    load_program(argv[1]);
-    run();
+    if (argc < 2) {
+        printf("Kullanim: %s <bytecode_file> [--stats] [sinirlar]\n"
+               "          %s --serve <soket> [sinirlar]\n"
+               "          %s --client <soket> <bytecode_file>\n"
+               "Sinirlar: --max-steps N  --max-time MS  --max-depth N  --max-memory BAYT\n", argv[0], argv[0], argv[0]);
+        return 1;
+    }
+    Worker* w = main_worker();
+    if (strcmp(argv[1], "--client") == 0 && argc > 3) return client_main(argv[2], argv[3]);
+
+    int serve = strcmp(argv[1], "--serve") == 0 && argc > 2;
+    int stats = 0;
+    VmLimits limits = {0};
+    for (int i = serve ? 3 : 2; i < argc; i++) {
+        if (strcmp(argv[i], "--stats") == 0) stats = 1;
+        else if (i + 1 < argc && strcmp(argv[i], "--max-steps") == 0) limits.max_steps = atol(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "--max-time") == 0) limits.max_time_ms = atol(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "--max-depth") == 0) limits.max_depth = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "--max-memory") == 0) limits.max_memory = atol(argv[++i]);
+    }
+    if (serve) return serve_main(argv[2], &limits);
+
+    FILE* f = fopen(argv[1], "r");
+    if (!f) { printf("Dosya acilamadi: %s\n", argv[1]); return 1; }
+    VmError err;
+    Program* prog = load_program(f, err.message);
+    fclose(f);
+    if (!prog) { printf("%s\n", err.message); return 1; }
+    Exec* ex = exec_create(prog, stdin, stdout, &limits);
+    if (!ex) { printf("Bellek yetersiz!\n"); return 1; }
+    VmStatus status = exec_run(ex, w, &err);
+    if (status != VM_OK) { printf("%s\n", err.message); return status; }
+    if (stats) {
+        print_memo_stats(prog);
+        print_task_stats();
+        fprintf(stderr, "SIMD: %s\n", vec_isa_name());
+    }
     return 0;
 }
+#endif
@@ -0,0 +1,84 @@
+#ifndef VM_H
+#define VM_H
+#include <stdio.h>
+
+// --- SANAL MAKINE ---
+// Bytecode bir kez Program'a yuklenir (atlama ve cagri hedefleri yuklemede
+// cozulur); ayni Program farkli girdi/cikti akislariyla tekrar tekrar ve
+// ayni anda calistirilabilir. Memo onbellegi Program'a aittir, calistirmalar
+// arasinda korunur.
+//
+// Gomulu kullanim: vm.c -DVM_NO_MAIN ile derlenip simd.c ile baglanir.
+//
+//   Program* p = load_program(f, msg);
+//   Exec* ex = exec_create(p, stdin, stdout, &limits);
+//   VmError err;
+//   if (exec_run(ex, NULL, &err) != VM_OK) ... err.code, err.message
+//   exec_free(ex);
+
+typedef struct Program Program;
+typedef struct Worker Worker;
+typedef struct Exec Exec;
+
+#define VM_ERROR_SIZE 128
+
+// Komut satirinda cikis kodu olarak da kullanilir
+typedef enum {
+    VM_OK = 0,
+    VM_ERR_RUNTIME,  // Yigin tasmasi, dizi siniri, girdi hatasi...
+    VM_ERR_STEPS,    // Adim butcesi bitti
+    VM_ERR_TIME,     // Sure siniri asildi
+    VM_ERR_DEPTH,    // Cagri derinligi asildi
+    VM_ERR_MEMORY,   // Dizi bellegi siniri asildi
+    VM_ERR_ABORTED   // exec_abort ile durduruldu
+} VmStatus;
+
+typedef struct {
+    VmStatus code;
+    char message[VM_ERROR_SIZE];
+} VmError;
+
+// Sinirlar; 0 sinirsiz demektir. Adim, geriye atlama (dongu turu), cagri
+// ya da spawn'dir: duz kod programin boyundan uzun suremez, bu yuzden her
+// komutu saymadan calismayi sinirlar. Adim ve sure dilimler halinde
+// denetlenir (bkz. FUEL_SLICE), asim en fazla bir dilim gecikir.
+typedef struct {
+    long max_steps;
+    long max_time_ms;
+    int max_depth;   // Baglam basina cagri derinligi (en fazla 100)
+    long max_memory; // Canli dizi depolari ve spawn gorevleri (baglamlariyla), bayt
+    // Adim ya da sure siniri dolunca cagrilir (ayni anda tek bir is
+    // parcacigindan). Pozitif donus degeri kadar ek adim / ms verilir ve
+    // calisma kaldigi yerden surer; 0 donerse calisma o hatayla durur.
+    long (*on_limit)(Exec* exec, VmStatus which, void* user);
+    void* user;
+} VmLimits;
+
+// Hata olursa NULL doner, mesaj err'e yazilir
+Program* load_program(FILE* f, char* err);
+void free_program(Program* prog);
+
+// READ 'in'den okur, PRINT 'out'a yazar; limits NULL olabilir
+Exec* exec_create(Program* prog, FILE* in, FILE* out, const VmLimits* limits);
+// Programi bastan calistirir (Exec basina bir kez). Hata surec sonlanmadan
+// doner; err NULL degilse doldurulur. w NULL ise cagiran is parcacigina ait
+// isci kullanilir (main_worker); farkli is parcaciklari ayni anda cagirabilir.
+VmStatus exec_run(Exec* exec, Worker* w, VmError* err);
+// Herhangi bir is parcacigindan; calisma bir dilim icinde VM_ERR_ABORTED ile biter
+void exec_abort(Exec* exec);
+void exec_free(Exec* exec);
+
+// --- ISCI HAVUZU ---
+// reserved: kuyruktan is almayan is parcaciklari icin eklenecek isci sayisi
+void start_pool(int reserved);
+// Cagiran is parcacigina ait isci: ilk cagrida bir yuva alinir, is parcacigi
+// bitince sonrakine verilir. MAX_WORKERS yuva doluysa NULL.
+Worker* main_worker();
+// Isi havuzdaki bos bir iscide calistirir; kuyruk doluysa 0 doner
+int submit_job(void (*job)(Worker* w, void* arg), void* arg);
+
+// --- SUNUCU (serve.c) ---
+int serve_main(const char* path, const VmLimits* limits);
+int client_main(const char* path, const char* program_file);
+
+#endif